@@ -0,0 +1,821 @@
+/*
+ * benchmark.cpp
+ *
+ * Measures the Fibonacci heap against other priority queues on a set
+ * of workloads, to show which structure suits which workload.
+ * Baselines:
+ *    lazy-pq = std::priority_queue; decrease_val pushes a new entry and
+ *              stale entries are skipped when they reach the top
+ *    binary = binary heap that tracks the position of each element
+ *    pairing = pairing heap with one allocation per element
+ *    compact = CompactFibHeap, the array-based Fibonacci heap
+ *    rp = RankPairingHeap, which links trees as it inserts
+ *    radix = radix heap (monotone keys only, so Dijkstra trace only)
+ *
+ * Workloads, over n elements with unique keys:
+ *    uniform = random keys; n/10 removals, n/2 decreases by a random
+ *              amount, n/10 deletions, then the rest are removed
+ *    sorted = like uniform, but keys are inserted in increasing order
+ *             and decreased by the smallest possible amount
+ *    adversarial = keys are inserted in decreasing order, and the
+ *                  deepest elements are decreased to a new minimum
+ *    dijkstra = replay of the heap operations of Dijkstra's algorithm
+ *               on a random graph with n vertices and 8n edges, which
+ *               is dominated by decreases
+ * For each operation the benchmark reports nanoseconds per operation
+ * and the number of allocations made, along with the peak resident
+ * set size of the whole run. Each run is made in its own process so
+ * that peak memory is measured separately. merge is timed once per
+ * run, merging two heaps of n/2 elements.
+ *
+ * Build and run (POSIX only):
+ *    g++ -std=c++17 -O2 -DNDEBUG -o benchmark benchmark.cpp
+ *    ./benchmark [max_elements]
+ * Sizes run from 1K up to max_elements (1M by default) by factors of 10.
+ * At 100M elements a run needs tens of gigabytes of memory.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <new>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "fib-heap.h"
+#include "fib-heap-compact.h"
+#include "fib-heap-rank-pairing.h"
+
+typedef int64_t BenchKey;
+
+/*
+ * Allocation counting: every allocation in the process goes through
+ * these replacements of the global operator new
+ */
+static size_t numAllocs = 0;
+
+void *operator new(size_t size)
+{
+    numAllocs++;
+    void *p = malloc(size == 0 ? 1 : size);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+
+/*
+ * Keys hold a priority in their high bits and the element's ID in the
+ * low ID_BITS bits, which keeps keys unique so that every heap removes
+ * elements in the same order
+ */
+static const int ID_BITS = 27;
+static const BenchKey BASE_PRIORITY = BenchKey(1) << 33;
+
+static BenchKey make_key(BenchKey priority, size_t id)
+{
+    return (priority << ID_BITS) | BenchKey(id);
+}
+
+// Baselines
+
+/*
+ * Every heap below is wrapped in an adapter with the same interface,
+ * so that one driver can run every workload on every heap. Elements
+ * are named by IDs 0 to capacity - 1, shared by all heaps built for a
+ * run so that heaps of the same run can be merged.
+ */
+
+struct FibAdapter {
+    typedef FibHeap_ElemAddr Handle;
+    static constexpr const char *name = "fib";
+    static constexpr bool monotoneOnly = false;
+
+    explicit FibAdapter(size_t) {}
+    Handle insert(size_t, BenchKey key) { return heap.insert(key); }
+    BenchKey pop() { return heap.remove_min(); }
+    void decrease(Handle h, size_t, BenchKey key) { heap.decrease_val(h, key); }
+    void erase(Handle h, size_t) { heap.delete_elem(h); }
+    void merge(FibAdapter &other) { heap.merge(other.heap); }
+    size_t size() const { return heap.size(); }
+
+    FibHeap<BenchKey> heap;
+};
+
+struct CompactAdapter {
+    typedef FibHeap_ElemIndex Handle;
+    static constexpr const char *name = "compact";
+    static constexpr bool monotoneOnly = false;
+
+    explicit CompactAdapter(size_t) {}
+    Handle insert(size_t, BenchKey key) { return heap.insert(key); }
+    BenchKey pop() { return heap.remove_min(); }
+    void decrease(Handle h, size_t, BenchKey key) { heap.decrease_val(h, key); }
+    void erase(Handle h, size_t) { heap.delete_elem(h); }
+    void merge(CompactAdapter &other) { heap.merge(other.heap); }
+    size_t size() const { return heap.size(); }
+
+    CompactFibHeap<BenchKey> heap;
+};
+
+struct RankPairingAdapter {
+    typedef FibHeap_ElemAddr Handle;
+    static constexpr const char *name = "rp";
+    static constexpr bool monotoneOnly = false;
+
+    explicit RankPairingAdapter(size_t) {}
+    Handle insert(size_t, BenchKey key) { return heap.insert(key); }
+    BenchKey pop() { return heap.remove_min(); }
+    void decrease(Handle h, size_t, BenchKey key) { heap.decrease_val(h, key); }
+    void erase(Handle h, size_t) { heap.delete_elem(h); }
+    void merge(RankPairingAdapter &other) { heap.merge(other.heap); }
+    size_t size() const { return heap.size(); }
+
+    RankPairingHeap<BenchKey> heap;
+};
+
+struct LazyPQAdapter {
+    typedef size_t Handle;
+    static constexpr const char *name = "lazy-pq";
+    static constexpr bool monotoneOnly = false;
+    typedef std::pair<BenchKey, size_t> Entry;
+
+    explicit LazyPQAdapter(size_t capacity) : keys(capacity), alive(capacity, false), count(0) {}
+    Handle insert(size_t id, BenchKey key)
+    {
+        keys[id] = key;
+        alive[id] = true;
+        pq.push(Entry(key, id));
+        count++;
+        return id;
+    }
+    BenchKey pop()
+    {
+        skip_stale();
+        Entry top = pq.top();
+        pq.pop();
+        alive[top.second] = false;
+        count--;
+        return top.first;
+    }
+    void decrease(Handle, size_t id, BenchKey key)
+    {
+        keys[id] = key;
+        pq.push(Entry(key, id));
+    }
+    void erase(Handle, size_t id)
+    {
+        alive[id] = false;
+        count--;
+    }
+    void merge(LazyPQAdapter &other)
+    {
+        while (not other.pq.empty()) {
+            Entry entry = other.pq.top();
+            other.pq.pop();
+            if (other.alive[entry.second] and other.keys[entry.second] == entry.first) {
+                insert(entry.second, entry.first);
+                other.alive[entry.second] = false;
+            }
+        }
+        other.count = 0;
+    }
+    size_t size() const { return count; }
+
+    void skip_stale()
+    {
+        while (not alive[pq.top().second] or keys[pq.top().second] != pq.top().first) {
+            pq.pop();
+        }
+    }
+
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> pq;
+    std::vector<BenchKey> keys;
+    std::vector<bool> alive;
+    size_t count;
+};
+
+struct BinaryAdapter {
+    typedef size_t Handle;
+    static constexpr const char *name = "binary";
+    static constexpr bool monotoneOnly = false;
+
+    explicit BinaryAdapter(size_t capacity) : keys(capacity), pos(capacity) {}
+    Handle insert(size_t id, BenchKey key)
+    {
+        keys[id] = key;
+        pos[id] = heap.size();
+        heap.push_back(id);
+        sift_up(heap.size() - 1);
+        return id;
+    }
+    BenchKey pop()
+    {
+        BenchKey key = keys[heap[0]];
+        remove_at(0);
+        return key;
+    }
+    void decrease(Handle, size_t id, BenchKey key)
+    {
+        keys[id] = key;
+        sift_up(pos[id]);
+    }
+    void erase(Handle, size_t id) { remove_at(pos[id]); }
+    void merge(BinaryAdapter &other)
+    {
+        for (size_t id : other.heap) {
+            keys[id] = other.keys[id];
+            pos[id] = heap.size();
+            heap.push_back(id);
+        }
+        other.heap.clear();
+        for (size_t i = heap.size() / 2; i-- > 0;) {
+            sift_down(i);
+        }
+    }
+    size_t size() const { return heap.size(); }
+
+    void place(size_t i, size_t id)
+    {
+        heap[i] = id;
+        pos[id] = i;
+    }
+    void sift_up(size_t i)
+    {
+        size_t id = heap[i];
+        while (i > 0 and keys[id] < keys[heap[(i - 1) / 2]]) {
+            place(i, heap[(i - 1) / 2]);
+            i = (i - 1) / 2;
+        }
+        place(i, id);
+    }
+    void sift_down(size_t i)
+    {
+        size_t id = heap[i];
+        size_t n = heap.size();
+        while (2 * i + 1 < n) {
+            size_t c = 2 * i + 1;
+            if (c + 1 < n and keys[heap[c + 1]] < keys[heap[c]]) {
+                c++;
+            }
+            if (not (keys[heap[c]] < keys[id])) {
+                break;
+            }
+            place(i, heap[c]);
+            i = c;
+        }
+        place(i, id);
+    }
+    void remove_at(size_t i)
+    {
+        size_t last = heap.back();
+        heap.pop_back();
+        if (i < heap.size()) {
+            place(i, last);
+            sift_down(i);
+            sift_up(pos[last]);
+        }
+    }
+
+    std::vector<size_t> heap;
+    std::vector<BenchKey> keys;
+    std::vector<size_t> pos;
+};
+
+struct PairingAdapter {
+    /* prev = left sibling, or parent for the first child */
+    struct Node {
+        BenchKey key;
+        Node *child;
+        Node *next;
+        Node *prev;
+    };
+    typedef Node *Handle;
+    static constexpr const char *name = "pairing";
+    static constexpr bool monotoneOnly = false;
+
+    explicit PairingAdapter(size_t) : root(nullptr), count(0) {}
+    ~PairingAdapter()
+    {
+        std::vector<Node *> to_free;
+        if (root != nullptr) {
+            to_free.push_back(root);
+        }
+        while (not to_free.empty()) {
+            Node *node = to_free.back();
+            to_free.pop_back();
+            for (Node *c = node->child; c != nullptr; c = c->next) {
+                to_free.push_back(c);
+            }
+            delete node;
+        }
+    }
+    Handle insert(size_t, BenchKey key)
+    {
+        Node *node = new Node{key, nullptr, nullptr, nullptr};
+        root = meld(root, node);
+        count++;
+        return node;
+    }
+    BenchKey pop()
+    {
+        Node *old = root;
+        BenchKey key = old->key;
+        root = combine(old->child);
+        delete old;
+        count--;
+        return key;
+    }
+    void decrease(Handle node, size_t, BenchKey key)
+    {
+        node->key = key;
+        if (node != root) {
+            cut(node);
+            root = meld(root, node);
+        }
+    }
+    void erase(Handle node, size_t)
+    {
+        if (node == root) {
+            pop();
+            return;
+        }
+        cut(node);
+        root = meld(root, combine(node->child));
+        delete node;
+        count--;
+    }
+    void merge(PairingAdapter &other)
+    {
+        root = meld(root, other.root);
+        count += other.count;
+        other.root = nullptr;
+        other.count = 0;
+    }
+    size_t size() const { return count; }
+
+    static Node *meld(Node *a, Node *b)
+    {
+        if (a == nullptr) {
+            return b;
+        }
+        if (b == nullptr) {
+            return a;
+        }
+        if (b->key < a->key) {
+            std::swap(a, b);
+        }
+        b->prev = a;
+        b->next = a->child;
+        if (a->child != nullptr) {
+            a->child->prev = b;
+        }
+        a->child = b;
+        a->next = nullptr;
+        a->prev = nullptr;
+        return a;
+    }
+    static void cut(Node *node)
+    {
+        if (node->prev->child == node) {
+            node->prev->child = node->next;
+        } else {
+            node->prev->next = node->next;
+        }
+        if (node->next != nullptr) {
+            node->next->prev = node->prev;
+        }
+        node->next = nullptr;
+        node->prev = nullptr;
+    }
+    // Two-pass pairing of a list of siblings
+    static Node *combine(Node *first)
+    {
+        std::vector<Node *> &pairs = scratch();
+        pairs.clear();
+        while (first != nullptr) {
+            Node *a = first;
+            Node *b = a->next;
+            first = b != nullptr ? b->next : nullptr;
+            a->next = nullptr;
+            if (b != nullptr) {
+                b->next = nullptr;
+            }
+            pairs.push_back(meld(a, b));
+        }
+        Node *result = nullptr;
+        for (size_t i = pairs.size(); i-- > 0;) {
+            result = meld(pairs[i], result);
+        }
+        return result;
+    }
+    static std::vector<Node *> &scratch()
+    {
+        static std::vector<Node *> pairs;
+        return pairs;
+    }
+
+    Node *root;
+    size_t count;
+};
+
+struct RadixAdapter {
+    typedef size_t Handle;
+    static constexpr const char *name = "radix";
+    static constexpr bool monotoneOnly = true;
+    typedef std::pair<uint64_t, size_t> Entry;
+
+    explicit RadixAdapter(size_t capacity) : keys(capacity), alive(capacity, false), last(0), count(0) {}
+    Handle insert(size_t id, BenchKey key)
+    {
+        keys[id] = key;
+        alive[id] = true;
+        push(Entry(key, id));
+        count++;
+        return id;
+    }
+    BenchKey pop()
+    {
+        while (true) {
+            if (buckets[0].empty()) {
+                refill();
+            }
+            Entry entry = buckets[0].back();
+            buckets[0].pop_back();
+            if (alive[entry.second] and uint64_t(keys[entry.second]) == entry.first) {
+                alive[entry.second] = false;
+                count--;
+                return BenchKey(entry.first);
+            }
+        }
+    }
+    void decrease(Handle, size_t id, BenchKey key)
+    {
+        keys[id] = key;
+        push(Entry(key, id));
+    }
+    void erase(Handle, size_t id)
+    {
+        alive[id] = false;
+        count--;
+    }
+    size_t size() const { return count; }
+
+    void push(const Entry &entry)
+    {
+        uint64_t diff = entry.first ^ last;
+        buckets[diff == 0 ? 0 : 64 - __builtin_clzll(diff)].push_back(entry);
+    }
+    // Moves the smallest key to last and redistributes its bucket
+    void refill()
+    {
+        size_t i = 1;
+        while (buckets[i].empty()) {
+            i++;
+        }
+        last = buckets[i][0].first;
+        for (const Entry &entry : buckets[i]) {
+            last = std::min(last, entry.first);
+        }
+        std::vector<Entry> moving;
+        moving.swap(buckets[i]);
+        for (const Entry &entry : moving) {
+            push(entry);
+        }
+    }
+
+    std::vector<Entry> buckets[65];
+    std::vector<BenchKey> keys;
+    std::vector<bool> alive;
+    uint64_t last;
+    size_t count;
+};
+
+// Workloads
+
+enum WorkloadKind { UNIFORM, SORTED, ADVERSARIAL, DIJKSTRA };
+static const char *WORKLOAD_NAMES[] = {"uniform", "sorted", "adversarial", "dijkstra"};
+
+/*
+ * A phased workload: insert every key (key of ID i is inserts[i]),
+ * remove numWarmup minimums, apply the decreases in order, delete the
+ * listed IDs, then remove every remaining element
+ */
+struct PhasedWorkload {
+    std::vector<BenchKey> inserts;
+    size_t numWarmup;
+    std::vector<std::pair<size_t, BenchKey>> decreases;
+    std::vector<size_t> deletes;
+};
+
+static PhasedWorkload make_phased(WorkloadKind kind, size_t n, std::mt19937_64 &rng)
+{
+    PhasedWorkload w;
+    std::vector<BenchKey> priority(n);
+    for (size_t i = 0; i < n; i++) {
+        if (kind == UNIFORM) {
+            priority[i] = BASE_PRIORITY + BenchKey(rng() % uint64_t(BASE_PRIORITY));
+        } else if (kind == SORTED) {
+            priority[i] = BASE_PRIORITY + BenchKey(4 * i);
+        } else {
+            priority[i] = 2 * BASE_PRIORITY - BenchKey(i);
+        }
+        w.inserts.push_back(make_key(priority[i], i));
+    }
+
+    // Warmup removes the smallest keys, which forces a consolidation
+    w.numWarmup = n / 10;
+    std::vector<size_t> order(n);
+    for (size_t i = 0; i < n; i++) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(),
+              [&](size_t a, size_t b) { return w.inserts[a] < w.inserts[b]; });
+    std::vector<size_t> alive(order.begin() + w.numWarmup, order.end());
+
+    // Decrease targets; adversarial takes the largest keys first, which
+    // sit deepest in the trees, and makes each one the new minimum
+    BenchKey min_priority = priority[alive[0]];
+    size_t numDecreases = n / 2;
+    for (size_t k = 0; k < numDecreases and not alive.empty(); k++) {
+        size_t id;
+        if (kind == ADVERSARIAL) {
+            id = alive[alive.size() - 1 - k % alive.size()];
+            priority[id] = --min_priority;
+        } else {
+            id = alive[rng() % alive.size()];
+            BenchKey amount = kind == SORTED ? 1 : 1 + BenchKey(rng() % 1024);
+            priority[id] -= amount;
+        }
+        w.decreases.push_back(std::make_pair(id, make_key(priority[id], id)));
+    }
+
+    std::shuffle(alive.begin(), alive.end(), rng);
+    w.deletes.assign(alive.begin(), alive.begin() + std::min(alive.size(), n / 10));
+    return w;
+}
+
+/*
+ * A recorded trace of heap operations: INSERT and DECREASE carry an
+ * ID and a key, POP removes the minimum
+ */
+struct TraceOp {
+    enum { INSERT, DECREASE, POP } kind;
+    size_t id;
+    BenchKey key;
+};
+
+/*
+ * Records the heap operations made by Dijkstra's algorithm on a random
+ * graph with n vertices, each with an edge to the next vertex (so that
+ * every vertex is reached) and 7 random out-edges with weights 1-1000.
+ * Distances are used as keys directly, so ties are possible; every heap
+ * still removes the same sequence of keys.
+ */
+static std::vector<TraceOp> make_dijkstra_trace(size_t n, std::mt19937_64 &rng)
+{
+    std::vector<std::vector<std::pair<size_t, BenchKey>>> adj(n);
+    for (size_t v = 0; v < n; v++) {
+        adj[v].push_back(std::make_pair((v + 1) % n, 1 + BenchKey(rng() % 1000)));
+        for (int e = 0; e < 7; e++) {
+            adj[v].push_back(std::make_pair(rng() % n, 1 + BenchKey(rng() % 1000)));
+        }
+    }
+
+    std::vector<TraceOp> trace;
+    std::vector<BenchKey> dist(n, -1);
+    std::vector<bool> done(n, false);
+    typedef std::pair<BenchKey, size_t> Entry;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> pq;
+    dist[0] = 0;
+    pq.push(Entry(0, 0));
+    trace.push_back(TraceOp{TraceOp::INSERT, 0, 0});
+    while (not pq.empty()) {
+        Entry top = pq.top();
+        pq.pop();
+        if (done[top.second] or top.first != dist[top.second]) {
+            continue;
+        }
+        size_t u = top.second;
+        done[u] = true;
+        trace.push_back(TraceOp{TraceOp::POP, u, top.first});
+        for (const std::pair<size_t, BenchKey> &edge : adj[u]) {
+            size_t v = edge.first;
+            BenchKey d = dist[u] + edge.second;
+            if (done[v] or (dist[v] >= 0 and d >= dist[v])) {
+                continue;
+            }
+            trace.push_back(TraceOp{dist[v] < 0 ? TraceOp::INSERT : TraceOp::DECREASE, v, d});
+            dist[v] = d;
+            pq.push(Entry(d, v));
+        }
+    }
+    return trace;
+}
+
+// Driver
+
+/*
+ * Times one phase and accumulates it under an operation name
+ */
+struct OpStats {
+    const char *op;
+    size_t count;
+    double ns;
+    size_t allocs;
+};
+
+class Recorder {
+    public:
+        template <typename Fn>
+        void time(const char *op, size_t count, Fn fn)
+        {
+            size_t allocs_before = numAllocs;
+            auto start = std::chrono::steady_clock::now();
+            fn();
+            auto end = std::chrono::steady_clock::now();
+            double ns = std::chrono::duration<double, std::nano>(end - start).count();
+            size_t allocs = numAllocs - allocs_before;
+
+            for (OpStats &stats : ops) {
+                if (stats.op == op) {
+                    stats.count += count;
+                    stats.ns += ns;
+                    stats.allocs += allocs;
+                    return;
+                }
+            }
+            ops.push_back(OpStats{op, count, ns, allocs});
+        }
+
+        void report(const char *heap, const char *workload, size_t n)
+        {
+            struct rusage usage;
+            getrusage(RUSAGE_SELF, &usage);
+            double rss_mb = usage.ru_maxrss / 1024.0;
+            for (const OpStats &stats : ops) {
+                printf("%-8s %-12s %10zu %-10s %10.1f %12zu %10.1f\n", heap, workload, n, stats.op,
+                       stats.count == 0 ? 0.0 : stats.ns / stats.count, stats.allocs, rss_mb);
+            }
+            fflush(stdout);
+        }
+
+    private:
+        std::vector<OpStats> ops;
+};
+
+// Exits if keys did not come out of a heap in order
+static void check(bool ok, const char *heap, const char *what)
+{
+    if (not ok) {
+        fprintf(stderr, "ERROR: %s heap %s\n", heap, what);
+        exit(EXIT_FAILURE);
+    }
+}
+
+template <typename Heap>
+static void run_phased(const PhasedWorkload &w, Recorder &rec)
+{
+    size_t n = w.inserts.size();
+    std::vector<typename Heap::Handle> handles(n);
+    Heap heap(n);
+    BenchKey last = std::numeric_limits<BenchKey>::min();
+    bool in_order = true;
+
+    rec.time("insert", n, [&] {
+        for (size_t i = 0; i < n; i++) {
+            handles[i] = heap.insert(i, w.inserts[i]);
+        }
+    });
+    rec.time("remove_min", w.numWarmup, [&] {
+        for (size_t i = 0; i < w.numWarmup; i++) {
+            BenchKey key = heap.pop();
+            in_order = in_order and last < key;
+            last = key;
+        }
+    });
+    rec.time("decrease", w.decreases.size(), [&] {
+        for (const std::pair<size_t, BenchKey> &d : w.decreases) {
+            heap.decrease(handles[d.first], d.first, d.second);
+        }
+    });
+    rec.time("delete", w.deletes.size(), [&] {
+        for (size_t id : w.deletes) {
+            heap.erase(handles[id], id);
+        }
+    });
+    size_t remaining = heap.size();
+    last = std::numeric_limits<BenchKey>::min();
+    rec.time("remove_min", remaining, [&] {
+        for (size_t i = 0; i < remaining; i++) {
+            BenchKey key = heap.pop();
+            in_order = in_order and last < key;
+            last = key;
+        }
+    });
+    check(in_order and heap.size() == 0, Heap::name, "removed keys out of order");
+
+    // Merge two heaps of n/2 elements each
+    Heap a(n), b(n);
+    for (size_t i = 0; i < n; i++) {
+        (i % 2 == 0 ? a : b).insert(i, w.inserts[i]);
+    }
+    rec.time("merge", 1, [&] { a.merge(b); });
+    check(a.size() == n and b.size() == 0, Heap::name, "lost elements while merging");
+}
+
+template <typename Heap>
+static void run_trace(const std::vector<TraceOp> &trace, size_t n, Recorder &rec)
+{
+    std::vector<typename Heap::Handle> handles(n);
+    Heap heap(n);
+    BenchKey last = std::numeric_limits<BenchKey>::min();
+    bool in_order = true;
+
+    rec.time("trace-op", trace.size(), [&] {
+        for (const TraceOp &op : trace) {
+            if (op.kind == TraceOp::INSERT) {
+                handles[op.id] = heap.insert(op.id, op.key);
+            } else if (op.kind == TraceOp::DECREASE) {
+                heap.decrease(handles[op.id], op.id, op.key);
+            } else {
+                BenchKey key = heap.pop();
+                in_order = in_order and last <= key and key == op.key;
+                last = key;
+            }
+        }
+    });
+    check(in_order and heap.size() == 0, Heap::name, "did not follow Dijkstra's trace");
+}
+
+template <typename Heap>
+static void run(WorkloadKind kind, size_t n)
+{
+    std::mt19937_64 rng(n * 4 + kind);
+    Recorder rec;
+    if (kind == DIJKSTRA) {
+        std::vector<TraceOp> trace = make_dijkstra_trace(n, rng);
+        run_trace<Heap>(trace, n, rec);
+    } else if constexpr (not Heap::monotoneOnly) {
+        PhasedWorkload w = make_phased(kind, n, rng);
+        run_phased<Heap>(w, rec);
+    }
+    rec.report(Heap::name, WORKLOAD_NAMES[kind], n);
+}
+
+// Runs fn in a child process, so its peak memory is measured alone
+static void in_child(const std::function<void()> &fn)
+{
+    pid_t pid = fork();
+    if (pid == 0) {
+        fn();
+        exit(EXIT_SUCCESS);
+    }
+    int status;
+    waitpid(pid, &status, 0);
+    if (not WIFEXITED(status) or WEXITSTATUS(status) != EXIT_SUCCESS) {
+        fprintf(stderr, "ERROR: benchmark run failed\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    size_t max_elems = argc > 1 ? strtoull(argv[1], nullptr, 10) : 1000000;
+    if (max_elems < 1000 or max_elems >= (size_t(1) << ID_BITS)) {
+        fprintf(stderr, "Usage: %s [max_elements], with 1000 <= max_elements < %zu\n",
+                argv[0], size_t(1) << ID_BITS);
+        return EXIT_FAILURE;
+    }
+
+    printf("%-8s %-12s %10s %-10s %10s %12s %10s\n",
+           "heap", "workload", "n", "op", "ns/op", "allocs", "peak MB");
+    fflush(stdout);
+    for (size_t n = 1000; n <= max_elems; n *= 10) {
+        for (int k = UNIFORM; k <= DIJKSTRA; k++) {
+            WorkloadKind kind = WorkloadKind(k);
+            in_child([&] { run<FibAdapter>(kind, n); });
+            in_child([&] { run<CompactAdapter>(kind, n); });
+            in_child([&] { run<RankPairingAdapter>(kind, n); });
+            in_child([&] { run<LazyPQAdapter>(kind, n); });
+            in_child([&] { run<BinaryAdapter>(kind, n); });
+            in_child([&] { run<PairingAdapter>(kind, n); });
+            if (kind == DIJKSTRA) {
+                in_child([&] { run<RadixAdapter>(kind, n); });
+            }
+        }
+    }
+    return EXIT_SUCCESS;
+}
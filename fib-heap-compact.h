@@ -0,0 +1,120 @@
+/*
+ * fib-heap-compact.h
+ *
+ * Interface for a Fibonacci heap that stores its elements in parallel
+ * arrays instead of linked nodes. Element links are 32-bit indices
+ * into the arrays, so each element costs sizeof(Key) + 18 bytes (22
+ * bytes for int keys, against 48 bytes per node in FibHeap), and the
+ * trees walked by remove_min sit in a few contiguous arrays. Runtimes
+ * are the same as FibHeap's, except:
+ *    MERGE TWO HEAPS - O(m), m = capacity of the heap merged in
+ *
+ * Elements are identified by FibHeap_ElemIndex handles (indices into
+ * the arrays). A handle stays valid until its element is removed, and
+ * may then be reused for a later insert. At most 2^32 - 1 elements
+ * can be stored.
+ *
+ * CompactFibHeap offers the core operations of FibHeap, with Key,
+ * Compare and ErrorPolicy template parameters that work the same way.
+ */
+
+#ifndef FIB_HEAP_COMPACT_H
+#define FIB_HEAP_COMPACT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "fib-heap.h"
+
+typedef uint32_t FibHeap_ElemIndex;
+
+template <typename Key = FibHeap_ElemType, typename Compare = std::less<Key>, typename ErrorPolicy = FibHeap_ExitOnError>
+class CompactFibHeap {
+    public:
+        // Constructors and Assignment Operator Overloads; copies are deep
+        explicit CompactFibHeap(const Compare &comp = Compare());
+        CompactFibHeap(const CompactFibHeap &other) = default;
+        CompactFibHeap &operator =(const CompactFibHeap &rhs) = default;
+        CompactFibHeap(CompactFibHeap &&other) noexcept;
+        CompactFibHeap &operator =(CompactFibHeap &&rhs) noexcept;
+        void swap(CompactFibHeap &other) noexcept;
+
+        // Retrieve information
+        bool isEmpty() const;
+        int size() const;
+        Key get_min();
+        Key get_value(FibHeap_ElemIndex elem);
+
+        // Modify fibonacci heap
+        void reserve(size_t n);
+        FibHeap_ElemIndex insert(const Key &value);
+        Key remove_min();
+        void decrease_val(FibHeap_ElemIndex elem, const Key &value);
+        void delete_elem(FibHeap_ElemIndex elem);
+        FibHeap_ElemIndex merge(CompactFibHeap &other);
+        void clear();
+
+        // Checks if heap is valid, i.e. does not violate internal invariants
+        // (should always return true unless there is an implementation bug)
+        bool valid();
+
+    private:
+        // Link value for no element
+        static constexpr FibHeap_ElemIndex NONE = UINT32_MAX;
+        // Degree stored for array slots that hold no element
+        static constexpr uint8_t FREE_SLOT = UINT8_MAX;
+
+        Compare comp;
+
+        /* Element i of the heap is described by entry i of each array:
+         * keys = value stored by element
+         * parent = element's parent in tree; NONE if root
+         * child = any one of element's children; NONE if none
+         * left, right = neighbors in the ring of roots if element is a
+         *               root, or in parent's circular list of children
+         *               otherwise. Free slots are chained through right.
+         * degree = number of children; FREE_SLOT if the slot is free
+         * loser = has element lost a child?
+         */
+        std::vector<Key> keys;
+        std::vector<FibHeap_ElemIndex> parent;
+        std::vector<FibHeap_ElemIndex> child;
+        std::vector<FibHeap_ElemIndex> left;
+        std::vector<FibHeap_ElemIndex> right;
+        std::vector<uint8_t> degree;
+        std::vector<uint8_t> loser;
+
+        // Fibonacci heap data members. freeSlots is the first free slot
+        FibHeap_ElemIndex front;
+        FibHeap_ElemIndex min;
+        FibHeap_ElemIndex freeSlots;
+        int numElems;
+
+        // Scratch table used by remove_min to find trees of equal degree
+        std::vector<FibHeap_ElemIndex> degreeTable;
+
+        // Helper functions
+        FibHeap_ElemIndex new_slot(const Key &value);
+        void free_slot(FibHeap_ElemIndex elem);
+        void check_elem(FibHeap_ElemIndex elem, const char *message);
+        FibHeap_ElemIndex merge_trees(FibHeap_ElemIndex tree1, FibHeap_ElemIndex tree2);
+        void consolidate();
+        void link_root(FibHeap_ElemIndex root);
+        void remove_root(FibHeap_ElemIndex root);
+        void cut_to_root(FibHeap_ElemIndex elem);
+        void link_child(FibHeap_ElemIndex par, FibHeap_ElemIndex elem);
+        void cut_child(FibHeap_ElemIndex par, FibHeap_ElemIndex elem);
+};
+
+// Exchanges contents of two compact fibonacci heaps in constant time
+template <typename Key, typename Compare, typename ErrorPolicy>
+void swap(CompactFibHeap<Key, Compare, ErrorPolicy> &a, CompactFibHeap<Key, Compare, ErrorPolicy> &b) noexcept
+{
+    a.swap(b);
+}
+
+#include "fib-heap-compact.tpp"
+
+#endif
@@ -0,0 +1,608 @@
+/*
+ * fib-heap-compact.tpp
+ *
+ * Implementation of the compact Fibonacci heap declared in
+ * fib-heap-compact.h. The algorithms are those of fib-heap.tpp, with
+ * node pointers replaced by indices into the heap's arrays.
+ *
+ * This file is included at the bottom of fib-heap-compact.h and should not
+ * be compiled or included on its own.
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <utility>
+
+// default constructor -- creates empty heap
+template <typename Key, typename Compare, typename ErrorPolicy>
+CompactFibHeap<Key, Compare, ErrorPolicy>::CompactFibHeap(const Compare &comp) : comp(comp)
+{
+    front = NONE;
+    min = NONE;
+    freeSlots = NONE;
+    numElems = 0;
+}
+
+// move constructor -- takes over other instance's elements and leaves it empty
+template <typename Key, typename Compare, typename ErrorPolicy>
+CompactFibHeap<Key, Compare, ErrorPolicy>::CompactFibHeap(CompactFibHeap &&other) noexcept : comp(other.comp)
+{
+    front = NONE;
+    min = NONE;
+    freeSlots = NONE;
+    numElems = 0;
+
+    swap(other);
+}
+
+// move assignment operator -- frees current contents and takes over other's
+template <typename Key, typename Compare, typename ErrorPolicy>
+CompactFibHeap<Key, Compare, ErrorPolicy> &CompactFibHeap<Key, Compare, ErrorPolicy>::operator =(CompactFibHeap &&rhs) noexcept
+{
+    if (this != &rhs) {
+        clear();
+        swap(rhs);
+    }
+    return *this;
+}
+
+/*
+ * Exchanges contents of this instance with another instance in
+ * constant time. Handles move with their elements to the other instance.
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+void CompactFibHeap<Key, Compare, ErrorPolicy>::swap(CompactFibHeap &other) noexcept
+{
+    using std::swap;
+
+    swap(comp, other.comp);
+    keys.swap(other.keys);
+    parent.swap(other.parent);
+    child.swap(other.child);
+    left.swap(other.left);
+    right.swap(other.right);
+    degree.swap(other.degree);
+    loser.swap(other.loser);
+    swap(front, other.front);
+    swap(min, other.min);
+    swap(freeSlots, other.freeSlots);
+    swap(numElems, other.numElems);
+    degreeTable.swap(other.degreeTable);
+}
+
+/*
+ * Returns whether or not fibonacci heap is empty
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+bool CompactFibHeap<Key, Compare, ErrorPolicy>::isEmpty() const
+{
+    return front == NONE;
+}
+
+/*
+ * Returns the number of elements in the fibonacci heap
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+int CompactFibHeap<Key, Compare, ErrorPolicy>::size() const
+{
+    return numElems;
+}
+
+/*
+ * Returns the minimum element in the fibonacci heap
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+Key CompactFibHeap<Key, Compare, ErrorPolicy>::get_min()
+{
+    ErrorPolicy::check(not isEmpty(), "Heap is empty -- cannot get the minimum element");
+    return keys[min];
+}
+
+/*
+ * Retrieves the value of the element with inputted handle
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+Key CompactFibHeap<Key, Compare, ErrorPolicy>::get_value(FibHeap_ElemIndex elem)
+{
+    check_elem(elem, "Cannot get the value of an element that is not in the heap");
+    return keys[elem];
+}
+
+/*
+ * Makes room for n elements in total, so that inserting up to that
+ * many elements does not reallocate the arrays
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+void CompactFibHeap<Key, Compare, ErrorPolicy>::reserve(size_t n)
+{
+    keys.reserve(n);
+    parent.reserve(n);
+    child.reserve(n);
+    left.reserve(n);
+    right.reserve(n);
+    degree.reserve(n);
+    loser.reserve(n);
+}
+
+/*
+ * Inserts an element into the fibonacci heap and returns its handle
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+FibHeap_ElemIndex CompactFibHeap<Key, Compare, ErrorPolicy>::insert(const Key &value)
+{
+    FibHeap_ElemIndex elem = new_slot(value);
+    bool wasEmpty = isEmpty();
+    link_root(elem);
+    if (wasEmpty or comp(value, keys[min])) {
+        min = elem;
+    }
+    numElems++;
+    return elem;
+}
+
+/*
+ * Removes the minimum element from the fibonacci heap and returns it
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+Key CompactFibHeap<Key, Compare, ErrorPolicy>::remove_min()
+{
+    ErrorPolicy::check(not isEmpty(), "Heap is empty -- cannot remove the minimum element");
+
+    FibHeap_ElemIndex minElem = min;
+    Key old_min = std::move(keys[minElem]);
+
+    // Promote all children of minimum to roots
+    FibHeap_ElemIndex curr = child[minElem];
+    for (int i = 0; i < degree[minElem]; i++) {
+        FibHeap_ElemIndex next = right[curr];
+        parent[curr] = NONE;
+        loser[curr] = false;
+        link_root(curr);
+        curr = next;
+    }
+    child[minElem] = NONE;
+    degree[minElem] = 0;
+
+    numElems--;
+    remove_root(minElem);
+    free_slot(minElem);
+
+    if (numElems == 0) {
+        front = NONE;
+        min = NONE;
+        return old_min;
+    }
+
+    consolidate();
+    return old_min;
+}
+
+/*
+ * Decreases the value of the element with inputted handle to the
+ * inputted new value, which is expected to be less than its current value
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+void CompactFibHeap<Key, Compare, ErrorPolicy>::decrease_val(FibHeap_ElemIndex elem, const Key &value)
+{
+    check_elem(elem, "Cannot decrease the value of an element that is not in the heap");
+    ErrorPolicy::check(comp(value, keys[elem]), "ERROR: Can only decrease to a value lower than current value");
+
+    keys[elem] = value;
+    if (parent[elem] != NONE and comp(value, keys[parent[elem]])) {
+        cut_to_root(elem);
+    }
+    if (comp(value, keys[min])) {
+        min = elem;
+    }
+}
+
+/*
+ * Deletes element with inputted handle from heap
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+void CompactFibHeap<Key, Compare, ErrorPolicy>::delete_elem(FibHeap_ElemIndex elem)
+{
+    check_elem(elem, "Cannot delete an element that is not in the heap");
+
+    // Make element the root of its own tree and treat it as the minimum
+    if (parent[elem] != NONE) {
+        cut_to_root(elem);
+    }
+    min = elem;
+    remove_min();
+}
+
+/*
+ * Moves every element of other instance into this instance, leaving
+ * other instance empty. Other instance's arrays are appended to this
+ * instance's, so an element with handle h in other instance has
+ * handle h + offset afterwards, where offset is the returned value.
+ * Takes time linear in the capacity of other instance's arrays.
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+FibHeap_ElemIndex CompactFibHeap<Key, Compare, ErrorPolicy>::merge(CompactFibHeap &other)
+{
+    if (this == &other or other.isEmpty()) {
+        return 0;
+    }
+    if (keys.empty()) {
+        // Nothing to renumber, so just take over other instance's arrays
+        swap(other);
+        return 0;
+    }
+    ErrorPolicy::check((size_t)keys.size() + other.keys.size() < (size_t)NONE, "ERROR: Merged heap would have too many elements");
+
+    FibHeap_ElemIndex offset = keys.size();
+    auto shifted = [offset](FibHeap_ElemIndex link) {
+        return link == NONE ? NONE : link + offset;
+    };
+    keys.insert(keys.end(), other.keys.begin(), other.keys.end());
+    degree.insert(degree.end(), other.degree.begin(), other.degree.end());
+    loser.insert(loser.end(), other.loser.begin(), other.loser.end());
+    for (size_t i = 0; i < other.keys.size(); i++) {
+        parent.push_back(shifted(other.parent[i]));
+        child.push_back(shifted(other.child[i]));
+        left.push_back(shifted(other.left[i]));
+        right.push_back(shifted(other.right[i]));
+    }
+
+    // Chain other instance's free slots in front of this instance's
+    if (other.freeSlots != NONE) {
+        FibHeap_ElemIndex last = other.freeSlots + offset;
+        while (right[last] != NONE) {
+            last = right[last];
+        }
+        right[last] = freeSlots;
+        freeSlots = other.freeSlots + offset;
+    }
+
+    // Splice other instance's ring of roots into this instance's
+    FibHeap_ElemIndex otherFront = other.front + offset;
+    FibHeap_ElemIndex otherMin = other.min + offset;
+    if (isEmpty()) {
+        front = otherFront;
+        min = otherMin;
+    } else {
+        FibHeap_ElemIndex last = left[front];
+        FibHeap_ElemIndex otherLast = left[otherFront];
+        right[last] = otherFront;
+        left[otherFront] = last;
+        right[otherLast] = front;
+        left[front] = otherLast;
+        if (comp(keys[otherMin], keys[min])) {
+            min = otherMin;
+        }
+    }
+    numElems += other.numElems;
+
+    other.clear();
+    return offset;
+}
+
+/*
+ * Clears fibonacci heap of all elements and releases its arrays
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+void CompactFibHeap<Key, Compare, ErrorPolicy>::clear()
+{
+    std::vector<Key>().swap(keys);
+    std::vector<FibHeap_ElemIndex>().swap(parent);
+    std::vector<FibHeap_ElemIndex>().swap(child);
+    std::vector<FibHeap_ElemIndex>().swap(left);
+    std::vector<FibHeap_ElemIndex>().swap(right);
+    std::vector<uint8_t>().swap(degree);
+    std::vector<uint8_t>().swap(loser);
+    front = NONE;
+    min = NONE;
+    freeSlots = NONE;
+    numElems = 0;
+}
+
+/*
+ * Returns a free slot holding inputted value, unlinked from any other
+ * element, reusing a freed slot if there is one
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+FibHeap_ElemIndex CompactFibHeap<Key, Compare, ErrorPolicy>::new_slot(const Key &value)
+{
+    FibHeap_ElemIndex elem;
+    if (freeSlots != NONE) {
+        elem = freeSlots;
+        freeSlots = right[elem];
+        keys[elem] = value;
+    } else {
+        ErrorPolicy::check(keys.size() != (size_t)NONE, "ERROR: Heap cannot hold any more elements");
+        elem = keys.size();
+        keys.push_back(value);
+        parent.push_back(NONE);
+        child.push_back(NONE);
+        left.push_back(NONE);
+        right.push_back(NONE);
+        degree.push_back(0);
+        loser.push_back(false);
+    }
+
+    parent[elem] = NONE;
+    child[elem] = NONE;
+    left[elem] = NONE;
+    right[elem] = NONE;
+    degree[elem] = 0;
+    loser[elem] = false;
+    return elem;
+}
+
+/*
+ * Marks slot of a removed element as free and chains it onto the
+ * free list for reuse
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+void CompactFibHeap<Key, Compare, ErrorPolicy>::free_slot(FibHeap_ElemIndex elem)
+{
+    degree[elem] = FREE_SLOT;
+    parent[elem] = NONE;
+    right[elem] = freeSlots;
+    freeSlots = elem;
+}
+
+/*
+ * Reports inputted error message if inputted handle does not name an
+ * element in the heap
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+void CompactFibHeap<Key, Compare, ErrorPolicy>::check_elem(FibHeap_ElemIndex elem, const char *message)
+{
+    ErrorPolicy::check(elem < keys.size() and degree[elem] != FREE_SLOT, message);
+}
+
+/*
+ * Merge inputted tree1 and tree2, assuming both have the same degree
+ * and are not linked into the ring, and return the merged tree
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+FibHeap_ElemIndex CompactFibHeap<Key, Compare, ErrorPolicy>::merge_trees(FibHeap_ElemIndex tree1, FibHeap_ElemIndex tree2)
+{
+    // Have tree with smaller root adopt tree with larger root
+    if (comp(keys[tree2], keys[tree1])) {
+        std::swap(tree1, tree2);
+    }
+    link_child(tree1, tree2);
+    return tree1;
+}
+
+/*
+ * Merges trees in the ring until no two trees have the same degree,
+ * finding the new minimum along the way
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+void CompactFibHeap<Key, Compare, ErrorPolicy>::consolidate()
+{
+    size_t topDegree = 0;
+
+    // Open up the ring so that trees can be taken off of it one at a time
+    FibHeap_ElemIndex curr = front;
+    right[left[front]] = NONE;
+    while (curr != NONE) {
+        FibHeap_ElemIndex next = right[curr];
+        size_t deg = degree[curr];
+        while (deg < degreeTable.size() and degreeTable[deg] != NONE) {
+            curr = merge_trees(curr, degreeTable[deg]);
+            degreeTable[deg] = NONE;
+            deg++;
+        }
+        // A tree merged in from another heap can have a degree this 
+        // heap's table has never reached
+        if (deg >= degreeTable.size()) {
+            degreeTable.resize(deg + 1, NONE);
+        }
+        degreeTable[deg] = curr;
+        if (deg > topDegree) {
+            topDegree = deg;
+        }
+        curr = next;
+    }
+
+    // Relink remaining trees into the ring, locating the new minimum
+    // along the way, and leave the table empty for the next call
+    front = NONE;
+    min = NONE;
+    for (size_t deg = 0; deg <= topDegree; deg++) {
+        FibHeap_ElemIndex root = degreeTable[deg];
+        if (root != NONE) {
+            degreeTable[deg] = NONE;
+            link_root(root);
+            if (min == NONE or comp(keys[root], keys[min])) {
+                min = root;
+            }
+        }
+    }
+}
+
+/*
+ * Links inputted element into the ring of roots, just before front
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+void CompactFibHeap<Key, Compare, ErrorPolicy>::link_root(FibHeap_ElemIndex root)
+{
+    if (front == NONE) {
+        front = root;
+        left[root] = root;
+        right[root] = root;
+    } else {
+        right[root] = front;
+        left[root] = left[front];
+        right[left[front]] = root;
+        left[front] = root;
+    }
+}
+
+/*
+ * Unlinks inputted root from the ring of roots
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+void CompactFibHeap<Key, Compare, ErrorPolicy>::remove_root(FibHeap_ElemIndex root)
+{
+    if (right[root] == root) {
+        front = NONE;
+    } else {
+        right[left[root]] = right[root];
+        left[right[root]] = left[root];
+        if (front == root) {
+            front = right[root];
+        }
+    }
+}
+
+/*
+ * Moves the subtree rooted at inputted non-root element to a new tree,
+ * cutting each loser ancestor in turn (cascading cut), without
+ * updating the minimum
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+void CompactFibHeap<Key, Compare, ErrorPolicy>::cut_to_root(FibHeap_ElemIndex elem)
+{
+    FibHeap_ElemIndex curr = elem;
+    FibHeap_ElemIndex par = parent[elem];
+    while (par != NONE) {
+        cut_child(par, curr);
+        loser[curr] = false;
+        link_root(curr);
+        if (loser[par]) {
+            curr = par;
+            par = parent[par];
+        } else {
+            if (parent[par] != NONE) {
+                loser[par] = true;
+            }
+            break;
+        }
+    }
+}
+
+/*
+ * Links inputted element into list of children of par
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+void CompactFibHeap<Key, Compare, ErrorPolicy>::link_child(FibHeap_ElemIndex par, FibHeap_ElemIndex elem)
+{
+    parent[elem] = par;
+    loser[elem] = false;
+    FibHeap_ElemIndex first = child[par];
+    if (first == NONE) {
+        child[par] = elem;
+        left[elem] = elem;
+        right[elem] = elem;
+    } else {
+        right[elem] = first;
+        left[elem] = left[first];
+        right[left[first]] = elem;
+        left[first] = elem;
+    }
+    degree[par]++;
+}
+
+/*
+ * Unlinks inputted element from list of children of par
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+void CompactFibHeap<Key, Compare, ErrorPolicy>::cut_child(FibHeap_ElemIndex par, FibHeap_ElemIndex elem)
+{
+    if (right[elem] == elem) {
+        child[par] = NONE;
+    } else {
+        right[left[elem]] = right[elem];
+        left[right[elem]] = left[elem];
+        if (child[par] == elem) {
+            child[par] = right[elem];
+        }
+    }
+    parent[elem] = NONE;
+    degree[par]--;
+}
+
+/*
+ * Returns whether or not heap is valid (does not violate heap invariants) and
+ * prints an error message if this is not the case
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+bool CompactFibHeap<Key, Compare, ErrorPolicy>::valid()
+{
+    if ((front == NONE) != (min == NONE) or (min != NONE and degree[min] == FREE_SLOT)) {
+        std::cerr << "ERROR: Minimum does not match whether the heap is empty" << std::endl;
+        return false;
+    }
+
+    int countElems = 0;
+    for (size_t i = 0; i < keys.size(); i++) {
+        if (degree[i] == FREE_SLOT) {
+            continue;
+        }
+        countElems++;
+        if (parent[i] == NONE) {
+            if (comp(keys[i], keys[min])) {
+                std::cerr << "ERROR: Minimum is " << keys[min] << " while root " << keys[i]
+                     << " exists." << std::endl;
+                return false;
+            }
+        } else if (comp(keys[i], keys[parent[i]])) {
+            std::cerr << "ERROR: Element storing " << keys[i] << " is a child of " << keys[parent[i]]
+                 << ", violating min heap invariants." << std::endl;
+            return false;
+        }
+        if (right[left[i]] != i or left[right[i]] != i) {
+            std::cerr << "ERROR: Element storing " << keys[i]
+                 << " is not linked consistently with its siblings." << std::endl;
+            return false;
+        }
+
+        int numChildren = 0;
+        FibHeap_ElemIndex c = child[i];
+        if (c != NONE) {
+            do {
+                if (parent[c] != i or numChildren == degree[i]) {
+                    std::cerr << "ERROR: Element storing " << keys[i] << " does not have the "
+                         << (int)degree[i] << " children it is reporting." << std::endl;
+                    return false;
+                }
+                numChildren++;
+                c = right[c];
+            } while (c != child[i]);
+        }
+        if (numChildren != degree[i]) {
+            std::cerr << "ERROR: Element storing " << keys[i] << " has " << numChildren
+                 << " children but is reporting " << (int)degree[i] << " children." << std::endl;
+            return false;
+        }
+    }
+
+    int numRoots = 0;
+    if (front != NONE) {
+        FibHeap_ElemIndex curr = front;
+        do {
+            if (parent[curr] != NONE) {
+                std::cerr << "ERROR: Element storing " << keys[curr]
+                     << " is in the ring of roots but has a parent." << std::endl;
+                return false;
+            }
+            numRoots++;
+            curr = right[curr];
+        } while (curr != front and numRoots <= countElems);
+    }
+    int numParentless = 0;
+    for (size_t i = 0; i < keys.size(); i++) {
+        if (degree[i] != FREE_SLOT and parent[i] == NONE) {
+            numParentless++;
+        }
+    }
+    if (numRoots != numParentless) {
+        std::cerr << "ERROR: Ring of roots holds " << numRoots << " elements but "
+             << numParentless << " elements have no parent." << std::endl;
+        return false;
+    }
+    if (countElems != numElems) {
+        std::cerr << "ERROR: It is reported that there are " << numElems
+             << " elements in the heap when there are actually "
+             << countElems << " elements." << std::endl;
+        return false;
+    }
+    return true;
+}
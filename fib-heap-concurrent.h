@@ -0,0 +1,108 @@
+/*
+ * fib-heap-concurrent.h
+ *
+ * Interface for a thread-safe front-end to the Fibonacci heap. Any
+ * number of threads may call any function at the same time.
+ *
+ * Values inserted with insert() do not take a lock: they are pushed
+ * onto one of several lock-free staging stacks, picked per thread.
+ * Whichever thread next holds the heap's lock moves every staged value
+ * into the heap in one go (flat combining), so one lock acquisition
+ * does the work of many producers. A producer also takes its turn at
+ * combining once its stack grows long, if the lock is free, so staged
+ * values cannot pile up without bound. Combined nodes are handed back
+ * to their stack and taken from there by producers a whole list at a
+ * time, into a cache kept by each thread, so once the heap has warmed
+ * up insert() does not allocate.
+ *
+ * Consumers can take up to k elements per lock acquisition with
+ * remove_min_batch. Elements that need to be decreased later are
+ * inserted with insert_with_address, which takes the lock in order to
+ * return an address right away; addresses are valid until their element
+ * is removed by any thread.
+ *
+ * Compile with -pthread.
+ */
+
+#ifndef FIB_HEAP_CONCURRENT_H
+#define FIB_HEAP_CONCURRENT_H
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "fib-heap.h"
+
+template <typename Key = FibHeap_ElemType, typename Compare = std::less<Key>>
+class ConcurrentFibHeap {
+    public:
+        // Constructor, Destructor; heaps cannot be copied or moved
+        explicit ConcurrentFibHeap(const Compare &comp = Compare());
+        ~ConcurrentFibHeap();
+        ConcurrentFibHeap(const ConcurrentFibHeap &other) = delete;
+        ConcurrentFibHeap &operator =(const ConcurrentFibHeap &rhs) = delete;
+
+        // Retrieve information; results may be out of date by the time
+        // they are returned if other threads are modifying the heap
+        bool isEmpty();
+        int size();
+        bool get_min(Key *value_p);
+
+        // Modify fibonacci heap
+        void insert(const Key &value);
+        FibHeap_ElemAddr insert_with_address(const Key &value);
+        bool remove_min(Key *value_p);
+        size_t remove_min_batch(size_t k, std::vector<Key> &out);
+        void decrease_val(FibHeap_ElemAddr addr, const Key &value);
+        void delete_elem(FibHeap_ElemAddr addr);
+
+    private:
+        // A value waiting in a staging stack to be moved into the heap
+        struct Staged {
+            Key value;
+            Staged *next;
+        };
+
+        /* A lock-free stack of staged values. Values are pushed one at a
+         * time and only ever taken off all at once, so pushes cannot
+         * suffer from ABA problems. Each stack sits in its own cache line
+         * so that threads pushing onto different stacks do not contend.
+         * size = approximate number of values on the stack
+         * spare = nodes whose values have been combined, for reuse; also
+         *         only ever taken off all at once
+         */
+        struct alignas(64) StagingStack {
+            std::atomic<Staged *> head{nullptr};
+            std::atomic<size_t> size{0};
+            std::atomic<Staged *> spare{nullptr};
+        };
+
+        // Nodes a thread has taken for reuse, shared by all heaps of
+        // this type; freed when the thread exits
+        struct StagedCache {
+            Staged *head = nullptr;
+            ~StagedCache();
+        };
+
+        static const size_t NUM_STACKS = 16;
+        // Stack length at which a producer tries to combine
+        static const size_t COMBINE_THRESHOLD = 256;
+
+        StagingStack stacks[NUM_STACKS];
+
+        // Lock guarding heap; held while combining and for every heap operation
+        std::mutex heapLock;
+        FibHeap<Key, Compare> heap;
+
+        // Helper functions
+        static size_t thread_stack();
+        static Staged *new_staged(StagingStack &stack, const Key &value);
+        static void free_list(Staged *staged);
+        void combine();
+};
+
+#include "fib-heap-concurrent.tpp"
+
+#endif
@@ -0,0 +1,244 @@
+/*
+ * fib-heap-concurrent.tpp
+ *
+ * Implementation of the thread-safe Fibonacci heap front-end declared
+ * in fib-heap-concurrent.h.
+ *
+ * This file is included at the bottom of fib-heap-concurrent.h and should not
+ * be compiled or included on its own.
+ */
+
+#include <algorithm>
+#include <iterator>
+
+// constructor -- creates empty heap. Combined values are buffered by the
+// heap so that each batch is linked into trees in one pass.
+template <typename Key, typename Compare>
+ConcurrentFibHeap<Key, Compare>::ConcurrentFibHeap(const Compare &comp) : heap(comp)
+{
+    heap.set_insert_buffer();
+}
+
+// destructor -- frees values still waiting in the staging stacks, and
+// nodes kept for reuse
+template <typename Key, typename Compare>
+ConcurrentFibHeap<Key, Compare>::~ConcurrentFibHeap()
+{
+    for (size_t i = 0; i < NUM_STACKS; i++) {
+        free_list(stacks[i].head.load(std::memory_order_acquire));
+        free_list(stacks[i].spare.load(std::memory_order_acquire));
+    }
+}
+
+// destructor -- frees the nodes a thread still has cached when it exits
+template <typename Key, typename Compare>
+ConcurrentFibHeap<Key, Compare>::StagedCache::~StagedCache()
+{
+    free_list(head);
+}
+
+/*
+ * Returns whether or not the heap is empty, counting staged values
+ */
+template <typename Key, typename Compare>
+bool ConcurrentFibHeap<Key, Compare>::isEmpty()
+{
+    return size() == 0;
+}
+
+/*
+ * Returns the number of elements in the heap, counting staged values
+ */
+template <typename Key, typename Compare>
+int ConcurrentFibHeap<Key, Compare>::size()
+{
+    std::lock_guard<std::mutex> guard(heapLock);
+    combine();
+    return heap.size();
+}
+
+/*
+ * Writes the minimum element to *value_p and returns true, or returns
+ * false if the heap is empty
+ */
+template <typename Key, typename Compare>
+bool ConcurrentFibHeap<Key, Compare>::get_min(Key *value_p)
+{
+    std::lock_guard<std::mutex> guard(heapLock);
+    combine();
+    if (heap.isEmpty()) {
+        return false;
+    }
+    *value_p = heap.get_min();
+    return true;
+}
+
+/*
+ * Inserts an element without taking the heap's lock. The element is
+ * staged and moved into the heap by the next thread to take the lock.
+ */
+template <typename Key, typename Compare>
+void ConcurrentFibHeap<Key, Compare>::insert(const Key &value)
+{
+    StagingStack &stack = stacks[thread_stack()];
+    Staged *staged = new_staged(stack, value);
+    staged->next = stack.head.load(std::memory_order_relaxed);
+    while (not stack.head.compare_exchange_weak(staged->next, staged,
+                                                std::memory_order_release,
+                                                std::memory_order_relaxed)) {
+    }
+
+    // Take a turn at combining if values are piling up and nobody else is
+    if (stack.size.fetch_add(1, std::memory_order_relaxed) + 1 >= COMBINE_THRESHOLD) {
+        std::unique_lock<std::mutex> guard(heapLock, std::try_to_lock);
+        if (guard.owns_lock()) {
+            combine();
+        }
+    }
+}
+
+/*
+ * Inserts an element and returns the address of the node storing it,
+ * for use with decrease_val and delete_elem. Takes the heap's lock.
+ */
+template <typename Key, typename Compare>
+FibHeap_ElemAddr ConcurrentFibHeap<Key, Compare>::insert_with_address(const Key &value)
+{
+    std::lock_guard<std::mutex> guard(heapLock);
+    combine();
+    return heap.insert(value);
+}
+
+/*
+ * Removes the minimum element, writes it to *value_p and returns true,
+ * or returns false if the heap is empty
+ */
+template <typename Key, typename Compare>
+bool ConcurrentFibHeap<Key, Compare>::remove_min(Key *value_p)
+{
+    std::lock_guard<std::mutex> guard(heapLock);
+    combine();
+    if (heap.isEmpty()) {
+        return false;
+    }
+    *value_p = heap.remove_min();
+    return true;
+}
+
+/*
+ * Removes up to k of the smallest elements under a single acquisition
+ * of the heap's lock, appending them to out in increasing order. They
+ * are taken with pop_k, so the heap is consolidated twice rather than
+ * once per element. Returns the number of elements removed, which is
+ * less than k only if the heap ran out of elements.
+ */
+template <typename Key, typename Compare>
+size_t ConcurrentFibHeap<Key, Compare>::remove_min_batch(size_t k, std::vector<Key> &out)
+{
+    std::lock_guard<std::mutex> guard(heapLock);
+    combine();
+    size_t count = std::min(k, (size_t)heap.size());
+    heap.pop_k(count, std::back_inserter(out));
+    return count;
+}
+
+/*
+ * Decreases the value held at inputted address, which must come from
+ * insert_with_address and must not have been removed yet
+ */
+template <typename Key, typename Compare>
+void ConcurrentFibHeap<Key, Compare>::decrease_val(FibHeap_ElemAddr addr, const Key &value)
+{
+    std::lock_guard<std::mutex> guard(heapLock);
+    heap.decrease_val(addr, value);
+}
+
+/*
+ * Deletes the element at inputted address, which must come from
+ * insert_with_address and must not have been removed yet
+ */
+template <typename Key, typename Compare>
+void ConcurrentFibHeap<Key, Compare>::delete_elem(FibHeap_ElemAddr addr)
+{
+    std::lock_guard<std::mutex> guard(heapLock);
+    heap.delete_elem(addr);
+}
+
+/*
+ * Returns the staging stack used by the calling thread. Threads are
+ * spread over the stacks in the order they first insert.
+ */
+template <typename Key, typename Compare>
+size_t ConcurrentFibHeap<Key, Compare>::thread_stack()
+{
+    static std::atomic<size_t> nextStack{0};
+    thread_local size_t stack = nextStack.fetch_add(1, std::memory_order_relaxed) % NUM_STACKS;
+    return stack;
+}
+
+/*
+ * Returns a node holding inputted value, to be pushed onto inputted
+ * stack. Nodes are taken from the calling thread's cache, which is
+ * refilled with all of the stack's spare nodes at once when empty, and
+ * are only allocated if neither has any.
+ */
+template <typename Key, typename Compare>
+typename ConcurrentFibHeap<Key, Compare>::Staged *ConcurrentFibHeap<Key, Compare>::new_staged(StagingStack &stack, const Key &value)
+{
+    thread_local StagedCache cache;
+    if (cache.head == nullptr) {
+        cache.head = stack.spare.exchange(nullptr, std::memory_order_acquire);
+        if (cache.head == nullptr) {
+            return new Staged{value, nullptr};
+        }
+    }
+    Staged *staged = cache.head;
+    cache.head = staged->next;
+    staged->value = value;
+    return staged;
+}
+
+/*
+ * Frees every node in the list starting at inputted node
+ */
+template <typename Key, typename Compare>
+void ConcurrentFibHeap<Key, Compare>::free_list(Staged *staged)
+{
+    while (staged != nullptr) {
+        Staged *next = staged->next;
+        delete staged;
+        staged = next;
+    }
+}
+
+/*
+ * Moves every staged value into the heap, and hands the nodes that held
+ * them back to their stack for reuse. Must be called with the heap's
+ * lock held.
+ */
+template <typename Key, typename Compare>
+void ConcurrentFibHeap<Key, Compare>::combine()
+{
+    for (size_t i = 0; i < NUM_STACKS; i++) {
+        StagingStack &stack = stacks[i];
+        if (stack.head.load(std::memory_order_relaxed) == nullptr) {
+            continue;
+        }
+        Staged *first = stack.head.exchange(nullptr, std::memory_order_acquire);
+        Staged *last = first;
+        size_t count = 1;
+        heap.insert(first->value);
+        while (last->next != nullptr) {
+            last = last->next;
+            heap.insert(last->value);
+            count++;
+        }
+        stack.size.fetch_sub(count, std::memory_order_relaxed);
+
+        last->next = stack.spare.load(std::memory_order_relaxed);
+        while (not stack.spare.compare_exchange_weak(last->next, first,
+                                                     std::memory_order_release,
+                                                     std::memory_order_relaxed)) {
+        }
+    }
+}
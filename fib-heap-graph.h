@@ -0,0 +1,95 @@
+/*
+ * fib-heap-graph.h
+ *
+ * Interface for shortest path and minimum spanning tree algorithms run
+ * on top of the Fibonacci heap. Graphs are given in compressed sparse
+ * row (CSR) form: the edges leaving vertex v are the edges numbered
+ * offsets[v] to offsets[v + 1] - 1, and edge e goes to targets[e] with
+ * weight weights[e]. Both algorithms keep the heap address of each
+ * vertex in a flat array indexed by vertex, so relaxing an edge is a
+ * single decrease_val call. Runtimes, for V vertices and E edges:
+ *    SHORTEST PATHS FROM A SOURCE (DIJKSTRA) - O(E + V log V)
+ *    MINIMUM SPANNING FOREST (PRIM) - O(E + V log V)
+ *
+ * Weight is the type of edge weights (FibHeap_ElemType by default).
+ * Shortest paths require non-negative weights. With integer weights,
+ * they can also be found with a monotone heap (see FibHeap::set_monotone),
+ * which keeps the distances within the largest edge weight of the last
+ * one settled in buckets; when the weights are small, such as road or
+ * grid graphs with weights below a few thousand, this does away with
+ * the heap's trees almost completely.
+ */
+
+#ifndef FIB_HEAP_GRAPH_H
+#define FIB_HEAP_GRAPH_H
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "fib-heap.h"
+
+// Parent of vertices that have no parent, i.e. sources, roots of
+// spanning trees, and vertices that cannot be reached
+const size_t FibHeap_NoVertex = static_cast<size_t>(-1);
+
+// Most buckets used by a monotone shortest path search; distances further
+// above the last one settled than this go into the heap's trees
+const size_t FibHeap_MaxMonotoneWindow = 1 << 16;
+
+/*
+ * A directed graph in CSR form. offsets must hold numVertices + 1
+ * entries, and targets and weights must each hold offsets[numVertices]
+ * entries. Undirected graphs list every edge once in each direction.
+ */
+template <typename Weight = FibHeap_ElemType>
+struct FibHeap_CSRGraph {
+    size_t numVertices() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+
+    std::vector<size_t> offsets;
+    std::vector<size_t> targets;
+    std::vector<Weight> weights;
+};
+
+/*
+ * Result of a shortest path search:
+ * dist = length of shortest path from source to each vertex; the
+ *        largest value of Weight if the vertex cannot be reached
+ * parent = vertex before each vertex on its shortest path
+ */
+template <typename Weight = FibHeap_ElemType>
+struct FibHeap_ShortestPaths {
+    std::vector<Weight> dist;
+    std::vector<size_t> parent;
+};
+
+/*
+ * Result of a minimum spanning forest search:
+ * parent = neighbor each vertex is connected to in the forest
+ * weight = weight of the edge from each vertex to its parent (the
+ *          default Weight for roots)
+ * totalWeight = sum of the weights of all edges in the forest
+ */
+template <typename Weight = FibHeap_ElemType>
+struct FibHeap_SpanningTree {
+    std::vector<size_t> parent;
+    std::vector<Weight> weight;
+    Weight totalWeight;
+};
+
+// Shortest paths from source to every vertex (Dijkstra's algorithm),
+// optionally using a monotone heap (integer weights only)
+template <typename Weight>
+FibHeap_ShortestPaths<Weight> FibHeap_shortest_paths(const FibHeap_CSRGraph<Weight> &graph,
+                                                     size_t source, bool monotone = false);
+
+// Minimum spanning forest of an undirected graph (Prim's algorithm),
+// growing a tree from root first and then from every vertex not yet
+// reached
+template <typename Weight>
+FibHeap_SpanningTree<Weight> FibHeap_spanning_tree(const FibHeap_CSRGraph<Weight> &graph,
+                                                   size_t root = 0);
+
+#include "fib-heap-graph.tpp"
+
+#endif
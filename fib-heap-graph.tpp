@@ -0,0 +1,178 @@
+/*
+ * fib-heap-graph.tpp
+ *
+ * Implementation of the graph algorithms declared in fib-heap-graph.h.
+ *
+ * This file is included at the bottom of fib-heap-graph.h and should not 
+ * be compiled or included on its own.
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <type_traits>
+
+/*
+ * Exits with an error message if the graph's arrays do not describe
+ * a valid CSR graph, or if vertex is not one of its vertices
+ */
+template <typename Weight>
+void FibHeap_check_graph(const FibHeap_CSRGraph<Weight> &graph, size_t vertex)
+{
+    size_t n = graph.numVertices();
+    if (vertex >= n) {
+        std::cerr << "ERROR: Vertex " << vertex << " is not in the graph" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    if (graph.offsets[0] != 0 or graph.targets.size() != graph.offsets[n] or
+        graph.weights.size() != graph.offsets[n]) {
+        std::cerr << "ERROR: Graph offsets do not match its number of edges" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    for (size_t v = 0; v < n; v++) {
+        if (graph.offsets[v] > graph.offsets[v + 1]) {
+            std::cerr << "ERROR: Graph offsets must not decrease" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+    for (size_t e = 0; e < graph.targets.size(); e++) {
+        if (graph.targets[e] >= n) {
+            std::cerr << "ERROR: Edge " << e << " goes to vertex " << graph.targets[e]
+                 << ", which is not in the graph" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+/*
+ * Finds shortest paths from source to every vertex with Dijkstra's
+ * algorithm. Vertices are inserted into the heap when first reached,
+ * with the vertex stored as the payload, and their addresses are kept
+ * in a flat array so that relaxing an edge is one decrease_val call.
+ * Distances are settled in non-decreasing order, and every distance in
+ * the heap is at most the largest edge weight above the last one
+ * settled, so a monotone heap with a window one larger than that weight
+ * keeps all of them in buckets.
+ */
+template <typename Weight>
+FibHeap_ShortestPaths<Weight> FibHeap_shortest_paths(const FibHeap_CSRGraph<Weight> &graph,
+                                                     size_t source, bool monotone)
+{
+    FibHeap_check_graph(graph, source);
+    Weight max_weight = Weight();
+    for (size_t e = 0; e < graph.weights.size(); e++) {
+        if (graph.weights[e] < Weight()) {
+            std::cerr << "ERROR: Shortest paths require non-negative edge weights" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        if (max_weight < graph.weights[e]) {
+            max_weight = graph.weights[e];
+        }
+    }
+
+    size_t n = graph.numVertices();
+    FibHeap_ShortestPaths<Weight> result;
+    result.dist.assign(n, std::numeric_limits<Weight>::max());
+    result.parent.assign(n, FibHeap_NoVertex);
+
+    // Heap address of each vertex while it is in the heap; done marks
+    // vertices whose distance is final
+    std::vector<FibHeap_ElemAddr> addrs(n, nullptr);
+    std::vector<bool> done(n, false);
+    FibHeap<Weight, std::less<Weight>, size_t> heap;
+    if (monotone) {
+        if constexpr (std::is_integral<Weight>::value) {
+            size_t window = FibHeap_MaxMonotoneWindow;
+            if ((unsigned long long)max_weight < window) {
+                window = (size_t)max_weight + 1;
+            }
+            heap.set_monotone(window);
+        } else {
+            std::cerr << "ERROR: Monotone shortest paths require integer edge weights" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    result.dist[source] = Weight();
+    addrs[source] = heap.insert(Weight(), source);
+    while (not heap.isEmpty()) {
+        size_t u;
+        Weight dist_u = heap.remove_min(&u);
+        addrs[u] = nullptr;
+        done[u] = true;
+
+        for (size_t e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+            size_t v = graph.targets[e];
+            Weight dist_v = dist_u + graph.weights[e];
+            if (done[v] or not (dist_v < result.dist[v])) {
+                continue;
+            }
+            result.dist[v] = dist_v;
+            result.parent[v] = u;
+            if (addrs[v] == nullptr) {
+                addrs[v] = heap.insert(dist_v, v);
+            } else {
+                heap.decrease_val(addrs[v], dist_v);
+            }
+        }
+    }
+
+    return result;
+}
+
+/*
+ * Finds a minimum spanning forest of an undirected graph with Prim's
+ * algorithm. A tree is grown from root, then from each vertex left
+ * unreached, so a disconnected graph gives one tree per component.
+ * Heap addresses of vertices are kept in a flat array, as above.
+ */
+template <typename Weight>
+FibHeap_SpanningTree<Weight> FibHeap_spanning_tree(const FibHeap_CSRGraph<Weight> &graph,
+                                                   size_t root)
+{
+    FibHeap_check_graph(graph, root);
+
+    size_t n = graph.numVertices();
+    FibHeap_SpanningTree<Weight> result;
+    result.parent.assign(n, FibHeap_NoVertex);
+    result.weight.assign(n, Weight());
+    result.totalWeight = Weight();
+
+    std::vector<FibHeap_ElemAddr> addrs(n, nullptr);
+    std::vector<bool> done(n, false);
+    FibHeap<Weight, std::less<Weight>, size_t> heap;
+
+    for (size_t i = 0; i < n; i++) {
+        size_t start = (root + i) % n;
+        if (done[start]) {
+            continue;
+        }
+
+        addrs[start] = heap.insert(Weight(), start);
+        while (not heap.isEmpty()) {
+            size_t u;
+            heap.remove_min(&u);
+            addrs[u] = nullptr;
+            done[u] = true;
+            result.totalWeight += result.weight[u];
+
+            for (size_t e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+                size_t v = graph.targets[e];
+                const Weight &w = graph.weights[e];
+                if (done[v]) {
+                    continue;
+                }
+                if (addrs[v] == nullptr) {
+                    addrs[v] = heap.insert(w, v);
+                } else if (w < result.weight[v]) {
+                    heap.decrease_val(addrs[v], w);
+                } else {
+                    continue;
+                }
+                result.weight[v] = w;
+                result.parent[v] = u;
+            }
+        }
+    }
+
+    return result;
+}
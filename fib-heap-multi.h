@@ -0,0 +1,93 @@
+/*
+ * fib-heap-multi.h
+ *
+ * Interface for a relaxed concurrent priority queue made of many
+ * independent Fibonacci heaps ("shards"), each with its own lock. Any
+ * number of threads may call any function at the same time.
+ *
+ * Inserts go to a random shard. remove_min looks at two random shards
+ * and removes the smaller of their minimums (power-of-two-choices), so
+ * threads rarely wait on each other, at the price of order: the element
+ * removed is close to, but not always, the overall minimum. This suits
+ * algorithms that tolerate approximate order, such as delta-stepping
+ * shortest paths. With c shards per thread, the removed element's rank
+ * is expected to be within O(c * P) of the minimum for P threads.
+ *
+ * Elements are identified by MultiFibHeap_Handle, which names the shard
+ * holding the element and its address in that shard. A handle is valid
+ * until its element is removed by any thread.
+ *
+ * Compile with -pthread.
+ */
+
+#ifndef FIB_HEAP_MULTI_H
+#define FIB_HEAP_MULTI_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "fib-heap.h"
+
+/* Identifies an element of a MultiFibHeap
+ * shard = index of shard holding the element
+ * addr = address of element within that shard
+ */
+struct MultiFibHeap_Handle {
+    size_t shard;
+    FibHeap_ElemAddr addr;
+};
+
+template <typename Key = FibHeap_ElemType, typename Compare = std::less<Key>>
+class MultiFibHeap {
+    public:
+        static const size_t DEFAULT_SHARDS_PER_THREAD = 2;
+
+        // Constructor; numThreads = 0 uses the machine's hardware
+        // concurrency. Heaps cannot be copied or moved.
+        explicit MultiFibHeap(size_t numThreads = 0,
+                              size_t shardsPerThread = DEFAULT_SHARDS_PER_THREAD,
+                              const Compare &comp = Compare());
+        MultiFibHeap(const MultiFibHeap &other) = delete;
+        MultiFibHeap &operator =(const MultiFibHeap &rhs) = delete;
+
+        // Retrieve information; results may be out of date by the time
+        // they are returned if other threads are modifying the heap
+        size_t num_shards() const;
+        bool isEmpty();
+        int size();
+        Key get_value(MultiFibHeap_Handle handle);
+
+        // Modify heap
+        MultiFibHeap_Handle insert(const Key &value);
+        bool remove_min(Key *value_p);
+        void decrease_val(MultiFibHeap_Handle handle, const Key &value);
+        void delete_elem(MultiFibHeap_Handle handle);
+        size_t merge(FibHeap<Key, Compare> &other);
+
+    private:
+        // Each shard sits in its own cache lines so that threads working
+        // on different shards do not contend
+        struct alignas(64) Shard {
+            std::mutex lock;
+            FibHeap<Key, Compare> heap;
+
+            explicit Shard(const Compare &comp) : heap(comp) {}
+        };
+
+        Compare comp;
+        std::vector<std::unique_ptr<Shard>> shards;
+
+        // Helper functions
+        size_t random_shard();
+        size_t lock_random_shard();
+        void check_shard(MultiFibHeap_Handle handle, const char *action);
+        bool remove_any(Key *value_p);
+};
+
+#include "fib-heap-multi.tpp"
+
+#endif
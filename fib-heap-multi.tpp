@@ -0,0 +1,245 @@
+/*
+ * fib-heap-multi.tpp
+ *
+ * Implementation of the sharded relaxed priority queue declared in
+ * fib-heap-multi.h.
+ *
+ * This file is included at the bottom of fib-heap-multi.h and should not
+ * be compiled or included on its own.
+ */
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+// constructor -- creates shardsPerThread empty shards per thread
+template <typename Key, typename Compare>
+MultiFibHeap<Key, Compare>::MultiFibHeap(size_t numThreads, size_t shardsPerThread,
+                                         const Compare &comp) : comp(comp)
+{
+    if (numThreads == 0) {
+        numThreads = std::thread::hardware_concurrency();
+    }
+    if (numThreads == 0) {
+        numThreads = 1;
+    }
+    if (shardsPerThread == 0) {
+        std::cerr << "Cannot create a heap with no shards per thread" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    // Two shards are needed for there to be two choices
+    size_t numShards = numThreads * shardsPerThread;
+    if (numShards < 2) {
+        numShards = 2;
+    }
+    shards.reserve(numShards);
+    for (size_t i = 0; i < numShards; i++) {
+        shards.emplace_back(new Shard(comp));
+    }
+}
+
+/*
+ * Returns the number of shards
+ */
+template <typename Key, typename Compare>
+size_t MultiFibHeap<Key, Compare>::num_shards() const
+{
+    return shards.size();
+}
+
+/*
+ * Returns whether or not every shard is empty
+ */
+template <typename Key, typename Compare>
+bool MultiFibHeap<Key, Compare>::isEmpty()
+{
+    return size() == 0;
+}
+
+/*
+ * Returns the number of elements across all shards. Shards are counted
+ * one at a time, so this is only a snapshot if no other thread is
+ * modifying the heap.
+ */
+template <typename Key, typename Compare>
+int MultiFibHeap<Key, Compare>::size()
+{
+    int total = 0;
+    for (const std::unique_ptr<Shard> &shard : shards) {
+        std::lock_guard<std::mutex> guard(shard->lock);
+        total += shard->heap.size();
+    }
+    return total;
+}
+
+/*
+ * Returns value of the element with inputted handle
+ */
+template <typename Key, typename Compare>
+Key MultiFibHeap<Key, Compare>::get_value(MultiFibHeap_Handle handle)
+{
+    check_shard(handle, "get value of");
+    Shard &shard = *shards[handle.shard];
+    std::lock_guard<std::mutex> guard(shard.lock);
+    return shard.heap.get_value(handle.addr);
+}
+
+/*
+ * Inserts an element into a random shard that no other thread holds,
+ * and returns its handle
+ */
+template <typename Key, typename Compare>
+MultiFibHeap_Handle MultiFibHeap<Key, Compare>::insert(const Key &value)
+{
+    size_t index = lock_random_shard();
+    Shard &shard = *shards[index];
+    std::lock_guard<std::mutex> guard(shard.lock, std::adopt_lock);
+    return MultiFibHeap_Handle{index, shard.heap.insert(value)};
+}
+
+/*
+ * Removes an element close to the minimum, writes it to *value_p and
+ * returns true, or returns false if every shard is empty. Two random
+ * shards are sampled and the smaller of their minimums is removed;
+ * shards held by other threads are skipped rather than waited on.
+ */
+template <typename Key, typename Compare>
+bool MultiFibHeap<Key, Compare>::remove_min(Key *value_p)
+{
+    // Sampled shards can all be empty when few elements are left, so
+    // after enough failed attempts fall back to searching every shard
+    for (size_t attempt = 0; attempt < shards.size(); attempt++) {
+        size_t i = random_shard();
+        size_t j = random_shard();
+        if (i == j) {
+            j = (j + 1) % shards.size();
+        }
+
+        std::unique_lock<std::mutex> guard1(shards[i]->lock, std::try_to_lock);
+        if (not guard1.owns_lock()) {
+            continue;
+        }
+        std::unique_lock<std::mutex> guard2(shards[j]->lock, std::try_to_lock);
+
+        FibHeap<Key, Compare> *best = nullptr;
+        if (not shards[i]->heap.isEmpty()) {
+            best = &shards[i]->heap;
+        }
+        if (guard2.owns_lock() and not shards[j]->heap.isEmpty()) {
+            FibHeap<Key, Compare> *other = &shards[j]->heap;
+            if (best == nullptr or comp(other->get_min(), best->get_min())) {
+                best = other;
+            }
+        }
+        if (best != nullptr) {
+            *value_p = best->remove_min();
+            return true;
+        }
+    }
+    return remove_any(value_p);
+}
+
+/*
+ * Decreases value of the element with inputted handle to inputted value
+ */
+template <typename Key, typename Compare>
+void MultiFibHeap<Key, Compare>::decrease_val(MultiFibHeap_Handle handle, const Key &value)
+{
+    check_shard(handle, "decrease value of");
+    Shard &shard = *shards[handle.shard];
+    std::lock_guard<std::mutex> guard(shard.lock);
+    shard.heap.decrease_val(handle.addr, value);
+}
+
+/*
+ * Deletes the element with inputted handle
+ */
+template <typename Key, typename Compare>
+void MultiFibHeap<Key, Compare>::delete_elem(MultiFibHeap_Handle handle)
+{
+    check_shard(handle, "delete");
+    Shard &shard = *shards[handle.shard];
+    std::lock_guard<std::mutex> guard(shard.lock);
+    shard.heap.delete_elem(handle.addr);
+}
+
+/*
+ * Moves every element of inputted heap into one random shard in
+ * constant time, and empties inputted heap. Returns the index of that
+ * shard: an address addr from the inputted heap becomes the handle
+ * {shard, addr}. This lets a thread build up elements in a private heap
+ * without locking, then publish them all at once.
+ */
+template <typename Key, typename Compare>
+size_t MultiFibHeap<Key, Compare>::merge(FibHeap<Key, Compare> &other)
+{
+    size_t index = lock_random_shard();
+    Shard &shard = *shards[index];
+    std::lock_guard<std::mutex> guard(shard.lock, std::adopt_lock);
+    shard.heap.merge(other);
+    return index;
+}
+
+/*
+ * Returns a random shard index, using a generator private to the
+ * calling thread (xorshift64*)
+ */
+template <typename Key, typename Compare>
+size_t MultiFibHeap<Key, Compare>::random_shard()
+{
+    static std::atomic<uint64_t> nextSeed{0x9E3779B97F4A7C15ULL};
+    thread_local uint64_t state =
+        nextSeed.fetch_add(0x9E3779B97F4A7C15ULL, std::memory_order_relaxed) | 1;
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return ((state * 0x2545F4914F6CDD1DULL) >> 32) % shards.size();
+}
+
+/*
+ * Locks a random shard that no other thread holds and returns its index
+ */
+template <typename Key, typename Compare>
+size_t MultiFibHeap<Key, Compare>::lock_random_shard()
+{
+    while (true) {
+        size_t index = random_shard();
+        if (shards[index]->lock.try_lock()) {
+            return index;
+        }
+    }
+}
+
+/*
+ * Exits with an error if inputted handle does not name a shard
+ */
+template <typename Key, typename Compare>
+void MultiFibHeap<Key, Compare>::check_shard(MultiFibHeap_Handle handle, const char *action)
+{
+    if (handle.shard >= shards.size()) {
+        std::cerr << "Cannot " << action << " an element that is not in the heap" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+}
+
+/*
+ * Removes the minimum of the first non-empty shard found, starting from
+ * a random shard and taking each lock in turn. Returns false if every
+ * shard was empty when visited.
+ */
+template <typename Key, typename Compare>
+bool MultiFibHeap<Key, Compare>::remove_any(Key *value_p)
+{
+    size_t start = random_shard();
+    for (size_t k = 0; k < shards.size(); k++) {
+        Shard &shard = *shards[(start + k) % shards.size()];
+        std::lock_guard<std::mutex> guard(shard.lock);
+        if (not shard.heap.isEmpty()) {
+            *value_p = shard.heap.remove_min();
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,129 @@
+/*
+ * fib-heap-rank-pairing.h
+ *
+ * Interface for a rank-pairing heap (Haeupler, Sen and Tarjan), an
+ * alternative to FibHeap with the same core interface, for callers
+ * that care about the cost of single operations more than about the
+ * total. FibHeap leaves inserted elements unlinked until the next
+ * remove_min, which then takes O(n) time after n inserts; here every
+ * root is linked with any other root of the same rank as soon as it
+ * appears, so there is never more than one root per rank and inserts
+ * never pile up work for remove_min. Runtimes:
+ *    RETRIEVE MIN ELEMENT - O(1)
+ *    INSERT ELEMENT - O(1) amortized, O(log n) worst case
+ *    REMOVE MIN ELEMENT - O(log n) amortized
+ *    DECREASE VALUE - O(1) amortized
+ *    DELETE VALUE - O(log n) amortized
+ *    MERGE TWO HEAPS - O(log n) worst case
+ * Insert and merge are bounded in the worst case by the table of one
+ * root per rank. remove_min is only bounded amortized: it makes a root
+ * of every node on the right spine of the minimum's left child, and
+ * decreases can leave that spine longer than log n.
+ *
+ * Each tree is stored as a half tree: a node's left pointer leads to
+ * its first child and its right pointer to its next sibling, so a node
+ * is no greater than anything in its left subtree, and a root has no
+ * right subtree. Decreasing a value cuts the node's half tree out, and
+ * restores the rank rule by lowering the ranks of its ancestors, in
+ * place of FibHeap's cascading cuts.
+ *
+ * Elements are identified by FibHeap_ElemAddr, as in FibHeap: an
+ * address stays valid until its element is removed, including across
+ * merges. RankPairingHeap offers the core operations of FibHeap, with
+ * Key, Compare and ErrorPolicy template parameters that work the same
+ * way, so code written against them can switch between the two by
+ * changing a typedef.
+ */
+
+#ifndef FIB_HEAP_RANK_PAIRING_H
+#define FIB_HEAP_RANK_PAIRING_H
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <vector>
+
+#include "fib-heap.h"
+
+template <typename Key = FibHeap_ElemType, typename Compare = std::less<Key>, typename ErrorPolicy = FibHeap_ExitOnError>
+class RankPairingHeap {
+    public:
+        // Constructors, Destructor, Assignment Operator Overloads; copies
+        // are deep, and addresses of the copied heap's elements do not
+        // carry over
+        explicit RankPairingHeap(const Compare &comp = Compare());
+        ~RankPairingHeap();
+        RankPairingHeap(const RankPairingHeap &other);
+        RankPairingHeap &operator =(const RankPairingHeap &rhs);
+        RankPairingHeap(RankPairingHeap &&other) noexcept;
+        RankPairingHeap &operator =(RankPairingHeap &&rhs) noexcept;
+        void swap(RankPairingHeap &other) noexcept;
+
+        // Retrieve information
+        bool isEmpty() const;
+        int size() const;
+        Key get_min();
+        std::optional<Key> try_get_min();
+        Key get_value(FibHeap_ElemAddr addr);
+
+        // Modify heap
+        FibHeap_ElemAddr insert(const Key &value);
+        Key remove_min();
+        std::optional<Key> try_remove_min();
+        void decrease_val(FibHeap_ElemAddr addr, const Key &value);
+        void delete_elem(FibHeap_ElemAddr addr);
+        void merge(RankPairingHeap &other);
+        void clear();
+
+        // Checks if heap is valid, i.e. does not violate internal invariants
+        // (should always return true unless there is an implementation bug)
+        bool valid();
+
+    private:
+        /* A node of a half tree:
+         * value = element stored in node
+         * rank = node's rank; a missing node has rank -1
+         * left = first child of node; nullptr if none
+         * right = next sibling of node; nullptr if none, and for roots
+         * parent = node whose left or right pointer leads to this node;
+         *          nullptr for roots
+         */
+        struct Node {
+            Key value;
+            int rank;
+            Node *left;
+            Node *right;
+            Node *parent;
+        };
+
+        Compare comp;
+
+        /* roots[r] = the root of rank r, or nullptr if there is none.
+         * Every root is in this table, so no two roots share a rank.
+         */
+        std::vector<Node *> roots;
+        Node *min;
+        int numElems;
+
+        // Helper functions
+        static int rank_of(const Node *node);
+        Node *link(Node *tree1, Node *tree2);
+        void add_root(Node *root);
+        void remove_root(Node *root);
+        void cut_to_root(Node *node);
+        void reduce_ranks(Node *node);
+        void find_min();
+        Node *copy_tree(const Node *root);
+        void delete_tree(Node *root);
+};
+
+// Exchanges contents of two rank-pairing heaps in constant time
+template <typename Key, typename Compare, typename ErrorPolicy>
+void swap(RankPairingHeap<Key, Compare, ErrorPolicy> &a, RankPairingHeap<Key, Compare, ErrorPolicy> &b) noexcept
+{
+    a.swap(b);
+}
+
+#include "fib-heap-rank-pairing.tpp"
+
+#endif
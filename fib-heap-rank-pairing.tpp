@@ -0,0 +1,560 @@
+/*
+ * fib-heap-rank-pairing.tpp
+ *
+ * Implementation of the rank-pairing heap declared in
+ * fib-heap-rank-pairing.h.
+ *
+ * This file is included at the bottom of fib-heap-rank-pairing.h and should not
+ * be compiled or included on its own.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <utility>
+
+// constructor -- creates empty heap
+template <typename Key, typename Compare, typename ErrorPolicy>
+RankPairingHeap<Key, Compare, ErrorPolicy>::RankPairingHeap(const Compare &comp) : comp(comp)
+{
+    min = nullptr;
+    numElems = 0;
+}
+
+// destructor -- frees every node
+template <typename Key, typename Compare, typename ErrorPolicy>
+RankPairingHeap<Key, Compare, ErrorPolicy>::~RankPairingHeap()
+{
+    clear();
+}
+
+// copy constructor -- copies every tree, keeping each root's rank
+template <typename Key, typename Compare, typename ErrorPolicy>
+RankPairingHeap<Key, Compare, ErrorPolicy>::RankPairingHeap(const RankPairingHeap &other) : comp(other.comp)
+{
+    roots.assign(other.roots.size(), nullptr);
+    min = nullptr;
+    for (size_t r = 0; r < other.roots.size(); r++) {
+        if (other.roots[r] != nullptr) {
+            roots[r] = copy_tree(other.roots[r]);
+            if (other.roots[r] == other.min) {
+                min = roots[r];
+            }
+        }
+    }
+    numElems = other.numElems;
+}
+
+/*
+ * Assignment operator overload -- performs a deep copy
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+RankPairingHeap<Key, Compare, ErrorPolicy> &RankPairingHeap<Key, Compare, ErrorPolicy>::operator =(const RankPairingHeap &rhs)
+{
+    if (this != &rhs) {
+        RankPairingHeap copy(rhs);
+        swap(copy);
+    }
+    return *this;
+}
+
+// move constructor -- takes other's nodes in constant time
+template <typename Key, typename Compare, typename ErrorPolicy>
+RankPairingHeap<Key, Compare, ErrorPolicy>::RankPairingHeap(RankPairingHeap &&other) noexcept
+    : comp(other.comp), roots(std::move(other.roots))
+{
+    min = other.min;
+    numElems = other.numElems;
+    other.roots.clear();
+    other.min = nullptr;
+    other.numElems = 0;
+}
+
+/*
+ * Move assignment operator overload -- frees this heap's nodes and
+ * takes rhs's in their place, leaving rhs empty
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+RankPairingHeap<Key, Compare, ErrorPolicy> &RankPairingHeap<Key, Compare, ErrorPolicy>::operator =(RankPairingHeap &&rhs) noexcept
+{
+    if (this != &rhs) {
+        clear();
+        swap(rhs);
+    }
+    return *this;
+}
+
+/*
+ * Exchanges contents with other heap in constant time
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+void RankPairingHeap<Key, Compare, ErrorPolicy>::swap(RankPairingHeap &other) noexcept
+{
+    using std::swap;
+    swap(comp, other.comp);
+    roots.swap(other.roots);
+    swap(min, other.min);
+    swap(numElems, other.numElems);
+}
+
+/*
+ * Returns whether or not the heap is empty
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+bool RankPairingHeap<Key, Compare, ErrorPolicy>::isEmpty() const
+{
+    return numElems == 0;
+}
+
+/*
+ * Returns the number of elements in the heap
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+int RankPairingHeap<Key, Compare, ErrorPolicy>::size() const
+{
+    return numElems;
+}
+
+/*
+ * Retrieves the value of the minimum element of the heap
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+Key RankPairingHeap<Key, Compare, ErrorPolicy>::get_min()
+{
+    ErrorPolicy::check(not isEmpty(), "Heap is empty -- cannot get the minimum element");
+    return min->value;
+}
+
+/*
+ * Retrieves the value of the minimum element of the heap, or returns an
+ * empty optional if the heap is empty
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+std::optional<Key> RankPairingHeap<Key, Compare, ErrorPolicy>::try_get_min()
+{
+    if (isEmpty()) {
+        return std::nullopt;
+    }
+    return min->value;
+}
+
+/*
+ * Retrieves the value stored at a specific address
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+Key RankPairingHeap<Key, Compare, ErrorPolicy>::get_value(FibHeap_ElemAddr addr)
+{
+    Node *node = (Node *)addr;
+    ErrorPolicy::check(node != nullptr, "Cannot get the value of a null node");
+    return node->value;
+}
+
+/*
+ * Inserts an element into the heap as a root of rank 0, linking it
+ * with the existing roots for as long as one has the same rank
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+FibHeap_ElemAddr RankPairingHeap<Key, Compare, ErrorPolicy>::insert(const Key &value)
+{
+    Node *node = new Node{value, 0, nullptr, nullptr, nullptr};
+    numElems++;
+    add_root(node);
+    return node;
+}
+
+/*
+ * Removes the minimum element from the heap and returns its value
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+Key RankPairingHeap<Key, Compare, ErrorPolicy>::remove_min()
+{
+    ErrorPolicy::check(not isEmpty(), "Heap is empty -- cannot remove the minimum element");
+    Key value = min->value;
+    remove_root(min);
+    return value;
+}
+
+/*
+ * Removes the minimum element from the heap and returns its value, or
+ * returns an empty optional if the heap is empty
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+std::optional<Key> RankPairingHeap<Key, Compare, ErrorPolicy>::try_remove_min()
+{
+    if (isEmpty()) {
+        return std::nullopt;
+    }
+    return remove_min();
+}
+
+/*
+ * Decreases the value held at inputted address to the inputted new
+ * value, which is expected to be lower than the current value. A first
+ * child that is still no smaller than its parent stays where it is;
+ * otherwise, unless the node is a root, its half tree is cut out and
+ * becomes a root.
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+void RankPairingHeap<Key, Compare, ErrorPolicy>::decrease_val(FibHeap_ElemAddr addr, const Key &value)
+{
+    Node *node = (Node *)addr;
+    ErrorPolicy::check(node != nullptr, "Cannot decrease the value of a null node");
+    ErrorPolicy::check(comp(value, node->value), "ERROR: Can only decrease to a value lower than current value");
+
+    node->value = value;
+    Node *parent = node->parent;
+    if (parent == nullptr) {
+        if (comp(value, min->value)) {
+            min = node;
+        }
+        return;
+    }
+    if (parent->left == node and not comp(value, parent->value)) {
+        return;
+    }
+    cut_to_root(node);
+    add_root(node);
+}
+
+/*
+ * Deletes the element at inputted address from the heap
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+void RankPairingHeap<Key, Compare, ErrorPolicy>::delete_elem(FibHeap_ElemAddr addr)
+{
+    Node *node = (Node *)addr;
+    ErrorPolicy::check(node != nullptr, "Cannot delete a null node");
+    if (node->parent != nullptr) {
+        cut_to_root(node);
+    }
+    remove_root(node);
+}
+
+/*
+ * Moves every element of other heap into this one, and empties other
+ * heap. Other's roots are added one by one, so this takes O(log n)
+ * time; addresses of other's elements stay valid.
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+void RankPairingHeap<Key, Compare, ErrorPolicy>::merge(RankPairingHeap &other)
+{
+    if (this == &other or other.isEmpty()) {
+        return;
+    }
+    for (Node *root : other.roots) {
+        if (root != nullptr) {
+            add_root(root);
+        }
+    }
+    numElems += other.numElems;
+    other.roots.clear();
+    other.min = nullptr;
+    other.numElems = 0;
+}
+
+/*
+ * Clears heap of all elements
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+void RankPairingHeap<Key, Compare, ErrorPolicy>::clear()
+{
+    for (Node *root : roots) {
+        if (root != nullptr) {
+            delete_tree(root);
+        }
+    }
+    roots.clear();
+    min = nullptr;
+    numElems = 0;
+}
+
+/*
+ * Checks if heap is valid: every root is in the table at its rank, every
+ * node is no greater than the nodes of its left subtree, ranks follow the
+ * rank rule, and the minimum and number of elements are correct
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+bool RankPairingHeap<Key, Compare, ErrorPolicy>::valid()
+{
+    int count = 0;
+    Node *smallest = nullptr;
+    for (size_t r = 0; r < roots.size(); r++) {
+        Node *root = roots[r];
+        if (root == nullptr) {
+            continue;
+        }
+        if (root->parent != nullptr or root->right != nullptr or root->rank != (int)r or
+            root->rank != rank_of(root->left) + 1) {
+            std::cerr << "ERROR: Root storing " << root->value << " in rank " << r
+                      << " does not have the shape or rank of a root of that rank" << std::endl;
+            return false;
+        }
+        if (smallest == nullptr or comp(root->value, smallest->value)) {
+            smallest = root;
+        }
+
+        // Each node is checked against the nearest node it is in the left
+        // subtree of, which it must be no smaller than
+        std::vector<std::pair<Node *, Node *>> stack = {{root, nullptr}};
+        while (not stack.empty()) {
+            Node *node = stack.back().first;
+            Node *bound = stack.back().second;
+            stack.pop_back();
+            count++;
+
+            if (bound != nullptr) {
+                if (comp(node->value, bound->value)) {
+                    std::cerr << "ERROR: Node storing " << node->value << " is below node storing "
+                              << bound->value << " but is smaller" << std::endl;
+                    return false;
+                }
+                int diff1 = node->rank - rank_of(node->left);
+                int diff2 = node->rank - rank_of(node->right);
+                int low = std::min(diff1, diff2);
+                int high = std::max(diff1, diff2);
+                if (not ((low == 1 and high <= 2) or (low == 0 and high >= 1))) {
+                    std::cerr << "ERROR: Node storing " << node->value << " has rank " << node->rank
+                              << " but children of ranks " << rank_of(node->left) << " and "
+                              << rank_of(node->right) << std::endl;
+                    return false;
+                }
+            }
+            if (node->left != nullptr) {
+                if (node->left->parent != node) {
+                    std::cerr << "ERROR: Node storing " << node->left->value
+                              << " does not point back to its parent" << std::endl;
+                    return false;
+                }
+                stack.push_back({node->left, node});
+            }
+            if (node->right != nullptr) {
+                if (node->right->parent != node) {
+                    std::cerr << "ERROR: Node storing " << node->right->value
+                              << " does not point back to its parent" << std::endl;
+                    return false;
+                }
+                stack.push_back({node->right, bound});
+            }
+        }
+    }
+
+    if (count != numElems) {
+        std::cerr << "ERROR: It is reported that there are " << numElems
+                  << " elements but trees hold " << count << std::endl;
+        return false;
+    }
+    if ((min == nullptr) != (smallest == nullptr) or
+        (min != nullptr and (min->parent != nullptr or comp(smallest->value, min->value)))) {
+        std::cerr << "ERROR: Minimum is not the smallest root" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/*
+ * Returns the rank of inputted node, or -1 if it is missing
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+int RankPairingHeap<Key, Compare, ErrorPolicy>::rank_of(const Node *node)
+{
+    return node == nullptr ? -1 : node->rank;
+}
+
+/*
+ * Links two roots of equal rank, making the one with the greater value
+ * the first child of the other, and returns the new root. On a tie the
+ * minimum stays a root.
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+typename RankPairingHeap<Key, Compare, ErrorPolicy>::Node *RankPairingHeap<Key, Compare, ErrorPolicy>::link(Node *tree1, Node *tree2)
+{
+    Node *winner = tree1;
+    Node *loser = tree2;
+    if (comp(tree2->value, tree1->value) or (tree2 == min and not comp(tree1->value, tree2->value))) {
+        winner = tree2;
+        loser = tree1;
+    }
+
+    loser->right = winner->left;
+    if (winner->left != nullptr) {
+        winner->left->parent = loser;
+    }
+    winner->left = loser;
+    loser->parent = winner;
+    winner->rank++;
+    return winner;
+}
+
+/*
+ * Adds inputted half tree to the roots, first linking it with the root
+ * of the same rank for as long as there is one, and updates the minimum
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+void RankPairingHeap<Key, Compare, ErrorPolicy>::add_root(Node *root)
+{
+    while (true) {
+        size_t r = root->rank;
+        if (r >= roots.size()) {
+            roots.resize(r + 1, nullptr);
+        }
+        if (roots[r] == nullptr) {
+            roots[r] = root;
+            break;
+        }
+        Node *other = roots[r];
+        roots[r] = nullptr;
+        root = link(root, other);
+    }
+
+    if (min == nullptr or comp(root->value, min->value)) {
+        min = root;
+    }
+}
+
+/*
+ * Frees inputted root, which may already be out of the table, and adds
+ * the nodes on the right spine of its left subtree as new roots. The
+ * minimum is searched for again if it was the root removed.
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+void RankPairingHeap<Key, Compare, ErrorPolicy>::remove_root(Node *root)
+{
+    if ((size_t)root->rank < roots.size() and roots[root->rank] == root) {
+        roots[root->rank] = nullptr;
+    }
+    bool wasMin = root == min;
+    if (wasMin) {
+        min = nullptr;
+    }
+
+    Node *child = root->left;
+    while (child != nullptr) {
+        Node *next = child->right;
+        child->right = nullptr;
+        child->parent = nullptr;
+        child->rank = rank_of(child->left) + 1;
+        add_root(child);
+        child = next;
+    }
+    delete root;
+    numElems--;
+
+    if (wasMin) {
+        find_min();
+    }
+}
+
+/*
+ * Cuts inputted node, which must not be a root, out of its tree along
+ * with its left subtree, giving it the rank of a root. Its right
+ * subtree takes its place. The node is not added to the roots.
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+void RankPairingHeap<Key, Compare, ErrorPolicy>::cut_to_root(Node *node)
+{
+    Node *parent = node->parent;
+    Node *replacement = node->right;
+    if (parent->left == node) {
+        parent->left = replacement;
+    } else {
+        parent->right = replacement;
+    }
+    if (replacement != nullptr) {
+        replacement->parent = parent;
+    }
+
+    node->right = nullptr;
+    node->parent = nullptr;
+    node->rank = rank_of(node->left) + 1;
+    reduce_ranks(parent);
+}
+
+/*
+ * Lowers the ranks of inputted node and its ancestors, after one of its
+ * subtrees has lost a half tree, until a rank no longer changes. Uses
+ * the type-2 rank rule: a node's rank is one more than the larger rank
+ * of its children if they differ by at most one, and equal to it
+ * otherwise. A root whose rank drops is moved in the table.
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+void RankPairingHeap<Key, Compare, ErrorPolicy>::reduce_ranks(Node *node)
+{
+    while (node->parent != nullptr) {
+        int rank1 = rank_of(node->left);
+        int rank2 = rank_of(node->right);
+        int rank = std::max(rank1, rank2);
+        if (std::abs(rank1 - rank2) <= 1) {
+            rank++;
+        }
+        if (rank >= node->rank) {
+            return;
+        }
+        node->rank = rank;
+        node = node->parent;
+    }
+
+    int rank = rank_of(node->left) + 1;
+    if (rank < node->rank) {
+        roots[node->rank] = nullptr;
+        node->rank = rank;
+        add_root(node);
+    }
+}
+
+/*
+ * Sets the minimum to the smallest root
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+void RankPairingHeap<Key, Compare, ErrorPolicy>::find_min()
+{
+    min = nullptr;
+    for (Node *root : roots) {
+        if (root != nullptr and (min == nullptr or comp(root->value, min->value))) {
+            min = root;
+        }
+    }
+}
+
+/*
+ * Copy half tree rooted at inputted node and return pointer to copy
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+typename RankPairingHeap<Key, Compare, ErrorPolicy>::Node *RankPairingHeap<Key, Compare, ErrorPolicy>::copy_tree(const Node *root)
+{
+    Node *root_cpy = new Node{root->value, root->rank, nullptr, nullptr, nullptr};
+    std::vector<std::pair<const Node *, Node *>> stack = {{root, root_cpy}};
+    while (not stack.empty()) {
+        const Node *node = stack.back().first;
+        Node *node_cpy = stack.back().second;
+        stack.pop_back();
+        if (node->left != nullptr) {
+            node_cpy->left = new Node{node->left->value, node->left->rank, nullptr, nullptr, node_cpy};
+            stack.push_back({node->left, node_cpy->left});
+        }
+        if (node->right != nullptr) {
+            node_cpy->right = new Node{node->right->value, node->right->rank, nullptr, nullptr, node_cpy};
+            stack.push_back({node->right, node_cpy->right});
+        }
+    }
+    return root_cpy;
+}
+
+/*
+ * Frees every node of the half tree rooted at inputted node
+ */
+template <typename Key, typename Compare, typename ErrorPolicy>
+void RankPairingHeap<Key, Compare, ErrorPolicy>::delete_tree(Node *root)
+{
+    std::vector<Node *> stack = {root};
+    while (not stack.empty()) {
+        Node *node = stack.back();
+        stack.pop_back();
+        if (node->left != nullptr) {
+            stack.push_back(node->left);
+        }
+        if (node->right != nullptr) {
+            stack.push_back(node->right);
+        }
+        delete node;
+    }
+}
@@ -0,0 +1,125 @@
+/*
+ * fib-heap-small.h
+ *
+ * Interface for a priority queue for heaps that are usually tiny, such
+ * as per-connection retry queues. Up to Capacity elements are stored
+ * inline, in an array inside the heap object ordered as a binary heap,
+ * so a small heap makes no allocation and its elements share a few
+ * cache lines. Inserting one element more than fits moves every element
+ * into a full FibHeap, which the heap keeps using until it is empty
+ * again. Runtimes while elements are inline:
+ *    RETRIEVE MIN ELEMENT - O(1)
+ *    REMOVE MIN ELEMENT, INSERT ELEMENT, DECREASE VALUE,
+ *    INCREASE VALUE, DELETE VALUE - O(log Capacity)
+ * and FibHeap's runtimes otherwise. Moving to the FibHeap takes
+ * O(Capacity) time once.
+ *
+ * Elements are identified by FibHeap_ElemAddr, as in FibHeap. The
+ * address of an element stored inline points into the heap object, and
+ * stays valid when the elements move to the FibHeap. It is invalidated
+ * if the heap object itself is copied, moved or swapped, so heaps whose
+ * addresses are kept should stay in one place. An address may be
+ * reused for a later insert once its element is removed.
+ *
+ * SmallFibHeap offers the core operations of FibHeap, with Key,
+ * Compare and ErrorPolicy template parameters that work the same way
+ * and come in the same order, followed by Capacity. Keys must be
+ * default constructible.
+ */
+
+#ifndef FIB_HEAP_SMALL_H
+#define FIB_HEAP_SMALL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "fib-heap.h"
+
+template <typename Key = FibHeap_ElemType, typename Compare = std::less<Key>, typename ErrorPolicy = FibHeap_ExitOnError, size_t Capacity = 32>
+class SmallFibHeap {
+    static_assert(Capacity > 0 and Capacity < UINT8_MAX, "SmallFibHeap holds from 1 to 254 elements inline");
+
+    public:
+        // Constructors, Assignment Operator Overloads; copies are deep
+        explicit SmallFibHeap(const Compare &comp = Compare());
+        SmallFibHeap(const SmallFibHeap &other);
+        SmallFibHeap &operator =(const SmallFibHeap &rhs);
+        SmallFibHeap(SmallFibHeap &&other);
+        SmallFibHeap &operator =(SmallFibHeap &&rhs);
+        void swap(SmallFibHeap &other);
+
+        // Retrieve information
+        bool isEmpty() const;
+        int size() const;
+        bool isInline() const;
+        Key get_min();
+        Key get_value(FibHeap_ElemAddr addr);
+        FibHeap_ElemAddr get_address(const Key &value);
+
+        // Modify heap
+        FibHeap_ElemAddr insert(const Key &value);
+        Key remove_min();
+        void decrease_val(FibHeap_ElemAddr addr, const Key &value);
+        void increase_val(FibHeap_ElemAddr addr, const Key &value);
+        void delete_elem(FibHeap_ElemAddr addr);
+        void merge(SmallFibHeap &other);
+        void clear();
+
+        // Checks if heap is valid, i.e. does not violate internal invariants
+        // (should always return true unless there is an implementation bug)
+        bool valid();
+
+    private:
+        // Position stored for slots that hold no element
+        static constexpr uint8_t FREE_SLOT = UINT8_MAX;
+
+        Compare comp;
+
+        /* Inline storage. Elements live in slots, which never move, so
+         * that a slot's address can identify its element.
+         * values = value stored in each slot
+         * order = binary heap of the numInline occupied slots, by value,
+         *         followed by the free slots in any order
+         * pos = position of each slot in order; FREE_SLOT if free
+         */
+        Key values[Capacity];
+        uint8_t order[Capacity];
+        uint8_t pos[Capacity];
+        size_t numInline;
+
+        /* Fibonacci heap holding the elements once they outgrow the
+         * slots (null until first needed). While it holds elements, no
+         * slot is occupied, and forward[i] is the address in it of the
+         * element that was in slot i when the elements moved. It shares
+         * this heap's error policy.
+         */
+        typedef FibHeap<Key, Compare, void, FibHeap_NoIndex, ErrorPolicy> Heap;
+        std::unique_ptr<Heap> heap;
+        std::vector<FibHeap_ElemAddr> forward;
+
+        // Helper functions
+        bool promoted() const;
+        void promote();
+        size_t slot_of(FibHeap_ElemAddr addr) const;
+        FibHeap_ElemAddr heap_address(FibHeap_ElemAddr addr, const char *message);
+        void check_slot(size_t slot, const char *message);
+        void place(size_t p, uint8_t slot);
+        void sift_up(size_t p);
+        void sift_down(size_t p);
+        void remove_at(size_t p);
+        void copy_slots(const SmallFibHeap &other);
+};
+
+// Exchanges contents of two small heaps
+template <typename Key, typename Compare, typename ErrorPolicy, size_t Capacity>
+void swap(SmallFibHeap<Key, Compare, ErrorPolicy, Capacity> &a, SmallFibHeap<Key, Compare, ErrorPolicy, Capacity> &b)
+{
+    a.swap(b);
+}
+
+#include "fib-heap-small.tpp"
+
+#endif
@@ -0,0 +1,491 @@
+/*
+ * fib-heap-small.tpp
+ *
+ * Implementation of the small-heap priority queue declared in
+ * fib-heap-small.h.
+ *
+ * This file is included at the bottom of fib-heap-small.h and should not
+ * be compiled or included on its own.
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <utility>
+
+// constructor -- creates empty heap with every slot free
+template <typename Key, typename Compare, typename ErrorPolicy, size_t Capacity>
+SmallFibHeap<Key, Compare, ErrorPolicy, Capacity>::SmallFibHeap(const Compare &comp) : comp(comp), values()
+{
+    for (size_t i = 0; i < Capacity; i++) {
+        order[i] = i;
+        pos[i] = FREE_SLOT;
+    }
+    numInline = 0;
+}
+
+// copy constructor -- addresses of other's elements do not carry over
+template <typename Key, typename Compare, typename ErrorPolicy, size_t Capacity>
+SmallFibHeap<Key, Compare, ErrorPolicy, Capacity>::SmallFibHeap(const SmallFibHeap &other) : comp(other.comp)
+{
+    copy_slots(other);
+}
+
+/*
+ * Assignment operator overload -- performs a deep copy;
+ * addresses of rhs's elements do not carry over
+ */
+template <typename Key, typename Compare, typename ErrorPolicy, size_t Capacity>
+SmallFibHeap<Key, Compare, ErrorPolicy, Capacity> &SmallFibHeap<Key, Compare, ErrorPolicy, Capacity>::operator =(const SmallFibHeap &rhs)
+{
+    if (this != &rhs) {
+        comp = rhs.comp;
+        copy_slots(rhs);
+    }
+    return *this;
+}
+
+/*
+ * Move constructor -- takes other's elements, leaving other empty.
+ * Addresses of elements other held inline do not carry over.
+ */
+template <typename Key, typename Compare, typename ErrorPolicy, size_t Capacity>
+SmallFibHeap<Key, Compare, ErrorPolicy, Capacity>::SmallFibHeap(SmallFibHeap &&other) : SmallFibHeap(other.comp)
+{
+    swap(other);
+}
+
+/*
+ * Move assignment operator overload -- takes rhs's elements, leaving
+ * rhs empty. Addresses of elements rhs held inline do not carry over.
+ */
+template <typename Key, typename Compare, typename ErrorPolicy, size_t Capacity>
+SmallFibHeap<Key, Compare, ErrorPolicy, Capacity> &SmallFibHeap<Key, Compare, ErrorPolicy, Capacity>::operator =(SmallFibHeap &&rhs)
+{
+    if (this != &rhs) {
+        clear();
+        swap(rhs);
+    }
+    return *this;
+}
+
+/*
+ * Exchanges contents with other heap. Takes O(Capacity) time, as the
+ * slots are swapped one by one.
+ */
+template <typename Key, typename Compare, typename ErrorPolicy, size_t Capacity>
+void SmallFibHeap<Key, Compare, ErrorPolicy, Capacity>::swap(SmallFibHeap &other)
+{
+    using std::swap;
+    swap(comp, other.comp);
+    swap(values, other.values);
+    swap(order, other.order);
+    swap(pos, other.pos);
+    swap(numInline, other.numInline);
+    swap(heap, other.heap);
+    swap(forward, other.forward);
+}
+
+/*
+ * Returns whether or not the heap is empty
+ */
+template <typename Key, typename Compare, typename ErrorPolicy, size_t Capacity>
+bool SmallFibHeap<Key, Compare, ErrorPolicy, Capacity>::isEmpty() const
+{
+    return size() == 0;
+}
+
+/*
+ * Returns the number of elements in the heap
+ */
+template <typename Key, typename Compare, typename ErrorPolicy, size_t Capacity>
+int SmallFibHeap<Key, Compare, ErrorPolicy, Capacity>::size() const
+{
+    return promoted() ? heap->size() : (int)numInline;
+}
+
+/*
+ * Returns whether the elements are stored inline, rather than in the
+ * Fibonacci heap they move to once they outgrow the slots
+ */
+template <typename Key, typename Compare, typename ErrorPolicy, size_t Capacity>
+bool SmallFibHeap<Key, Compare, ErrorPolicy, Capacity>::isInline() const
+{
+    return not promoted();
+}
+
+/*
+ * Retrieves the value of the minimum element of the heap
+ */
+template <typename Key, typename Compare, typename ErrorPolicy, size_t Capacity>
+Key SmallFibHeap<Key, Compare, ErrorPolicy, Capacity>::get_min()
+{
+    if (promoted()) {
+        return heap->get_min();
+    }
+    ErrorPolicy::check(numInline != 0, "Heap is empty -- cannot get the minimum element");
+    return values[order[0]];
+}
+
+/*
+ * Retrieves the value stored at a specific address
+ */
+template <typename Key, typename Compare, typename ErrorPolicy, size_t Capacity>
+Key SmallFibHeap<Key, Compare, ErrorPolicy, Capacity>::get_value(FibHeap_ElemAddr addr)
+{
+    if (promoted()) {
+        return heap->get_value(heap_address(addr, "Cannot get the value of an element that is not in the heap"));
+    }
+    size_t slot = slot_of(addr);
+    check_slot(slot, "Cannot get the value of an element that is not in the heap");
+    return values[slot];
+}
+
+/*
+ * Returns the address of an element holding inputted value, or nullptr
+ * if there is none. Takes linear time.
+ */
+template <typename Key, typename Compare, typename ErrorPolicy, size_t Capacity>
+FibHeap_ElemAddr SmallFibHeap<Key, Compare, ErrorPolicy, Capacity>::get_address(const Key &value)
+{
+    if (promoted()) {
+        return heap->get_address(value);
+    }
+    for (size_t p = 0; p < numInline; p++) {
+        uint8_t slot = order[p];
+        if (not comp(value, values[slot]) and not comp(values[slot], value)) {
+            return &values[slot];
+        }
+    }
+    return nullptr;
+}
+
+/*
+ * Inserts an element into the heap and returns its address. If every
+ * slot is taken, all elements first move to the Fibonacci heap.
+ */
+template <typename Key, typename Compare, typename ErrorPolicy, size_t Capacity>
+FibHeap_ElemAddr SmallFibHeap<Key, Compare, ErrorPolicy, Capacity>::insert(const Key &value)
+{
+    if (not promoted()) {
+        if (numInline < Capacity) {
+            uint8_t slot = order[numInline];
+            values[slot] = value;
+            place(numInline, slot);
+            numInline++;
+            sift_up(numInline - 1);
+            return &values[slot];
+        }
+        promote();
+    }
+    return heap->insert(value);
+}
+
+/*
+ * Removes the minimum element from the heap and returns its value.
+ * Once the Fibonacci heap is emptied, the next insert is stored inline.
+ */
+template <typename Key, typename Compare, typename ErrorPolicy, size_t Capacity>
+Key SmallFibHeap<Key, Compare, ErrorPolicy, Capacity>::remove_min()
+{
+    if (promoted()) {
+        return heap->remove_min();
+    }
+    ErrorPolicy::check(numInline != 0, "Heap is empty -- cannot remove the minimum element");
+    Key value = values[order[0]];
+    remove_at(0);
+    return value;
+}
+
+/*
+ * Decreases the value held at inputted address to the inputted new
+ * value, which is expected to be lower than the current value
+ */
+template <typename Key, typename Compare, typename ErrorPolicy, size_t Capacity>
+void SmallFibHeap<Key, Compare, ErrorPolicy, Capacity>::decrease_val(FibHeap_ElemAddr addr, const Key &value)
+{
+    if (promoted()) {
+        heap->decrease_val(heap_address(addr, "Cannot decrease the value of an element that is not in the heap"), value);
+        return;
+    }
+    size_t slot = slot_of(addr);
+    check_slot(slot, "Cannot decrease the value of an element that is not in the heap");
+    ErrorPolicy::check(comp(value, values[slot]), "ERROR: Can only decrease to a value lower than current value");
+    values[slot] = value;
+    sift_up(pos[slot]);
+}
+
+/*
+ * Increases the value held at inputted address to the inputted new
+ * value, which is expected to be greater than the current value; the
+ * address stays valid
+ */
+template <typename Key, typename Compare, typename ErrorPolicy, size_t Capacity>
+void SmallFibHeap<Key, Compare, ErrorPolicy, Capacity>::increase_val(FibHeap_ElemAddr addr, const Key &value)
+{
+    if (promoted()) {
+        heap->increase_val(heap_address(addr, "Cannot increase the value of an element that is not in the heap"), value);
+        return;
+    }
+    size_t slot = slot_of(addr);
+    check_slot(slot, "Cannot increase the value of an element that is not in the heap");
+    ErrorPolicy::check(comp(values[slot], value), "ERROR: Can only increase to a value greater than current value");
+    values[slot] = value;
+    sift_down(pos[slot]);
+}
+
+/*
+ * Deletes the element at inputted address from the heap
+ */
+template <typename Key, typename Compare, typename ErrorPolicy, size_t Capacity>
+void SmallFibHeap<Key, Compare, ErrorPolicy, Capacity>::delete_elem(FibHeap_ElemAddr addr)
+{
+    if (promoted()) {
+        heap->delete_elem(heap_address(addr, "Cannot delete an element that is not in the heap"));
+        return;
+    }
+    size_t slot = slot_of(addr);
+    check_slot(slot, "Cannot delete an element that is not in the heap");
+    remove_at(pos[slot]);
+}
+
+/*
+ * Moves every element of other heap into this one, and empties other
+ * heap. Unlike FibHeap::merge, addresses of other's elements become
+ * invalid. If both heaps hold their elements in Fibonacci heaps, those
+ * are merged in constant time; otherwise other's inline elements are
+ * inserted one by one.
+ */
+template <typename Key, typename Compare, typename ErrorPolicy, size_t Capacity>
+void SmallFibHeap<Key, Compare, ErrorPolicy, Capacity>::merge(SmallFibHeap &other)
+{
+    if (this == &other) {
+        return;
+    }
+
+    if (other.promoted()) {
+        if (not promoted()) {
+            promote();
+        }
+        heap->merge(*other.heap);
+    } else {
+        for (size_t p = 0; p < other.numInline; p++) {
+            insert(other.values[other.order[p]]);
+        }
+    }
+    other.clear();
+}
+
+/*
+ * Clears heap of all elements. The Fibonacci heap, if one was needed,
+ * is kept for reuse.
+ */
+template <typename Key, typename Compare, typename ErrorPolicy, size_t Capacity>
+void SmallFibHeap<Key, Compare, ErrorPolicy, Capacity>::clear()
+{
+    for (size_t p = 0; p < numInline; p++) {
+        pos[order[p]] = FREE_SLOT;
+    }
+    numInline = 0;
+    if (heap != nullptr) {
+        heap->clear();
+    }
+    forward.clear();
+}
+
+/*
+ * Checks if heap is valid: inline elements are in binary heap order
+ * with consistent positions, or the Fibonacci heap is valid while no
+ * element is inline
+ */
+template <typename Key, typename Compare, typename ErrorPolicy, size_t Capacity>
+bool SmallFibHeap<Key, Compare, ErrorPolicy, Capacity>::valid()
+{
+    if (numInline > Capacity) {
+        std::cerr << "ERROR: " << numInline << " elements are stored in " << Capacity << " slots" << std::endl;
+        return false;
+    }
+    for (size_t p = 0; p < Capacity; p++) {
+        uint8_t expected = p < numInline ? p : FREE_SLOT;
+        if (order[p] >= Capacity or pos[order[p]] != expected) {
+            std::cerr << "ERROR: Slot at position " << p << " does not record its position" << std::endl;
+            return false;
+        }
+        if (p > 0 and p < numInline and comp(values[order[p]], values[order[(p - 1) / 2]])) {
+            std::cerr << "ERROR: Slot storing " << values[order[p]] << " is below slot storing "
+                      << values[order[(p - 1) / 2]] << " but is smaller" << std::endl;
+            return false;
+        }
+    }
+    if (promoted()) {
+        if (numInline != 0) {
+            std::cerr << "ERROR: Elements are stored inline while the Fibonacci heap is in use" << std::endl;
+            return false;
+        }
+        return heap->valid();
+    }
+    return true;
+}
+
+/*
+ * Returns whether the elements are in the Fibonacci heap
+ */
+template <typename Key, typename Compare, typename ErrorPolicy, size_t Capacity>
+bool SmallFibHeap<Key, Compare, ErrorPolicy, Capacity>::promoted() const
+{
+    return heap != nullptr and not heap->isEmpty();
+}
+
+/*
+ * Moves every inline element into the Fibonacci heap, recording where
+ * each one went so that its inline address keeps working
+ */
+template <typename Key, typename Compare, typename ErrorPolicy, size_t Capacity>
+void SmallFibHeap<Key, Compare, ErrorPolicy, Capacity>::promote()
+{
+    if (heap == nullptr) {
+        heap.reset(new Heap(comp));
+    }
+    forward.assign(Capacity, nullptr);
+    for (size_t p = 0; p < numInline; p++) {
+        uint8_t slot = order[p];
+        forward[slot] = heap->insert(values[slot]);
+        pos[slot] = FREE_SLOT;
+    }
+    numInline = 0;
+}
+
+/*
+ * Returns the slot at inputted address, or Capacity if the address is
+ * not inside the inline storage
+ */
+template <typename Key, typename Compare, typename ErrorPolicy, size_t Capacity>
+size_t SmallFibHeap<Key, Compare, ErrorPolicy, Capacity>::slot_of(FibHeap_ElemAddr addr) const
+{
+    const Key *value_p = (const Key *)addr;
+    std::less<const Key *> before;
+    if (before(value_p, values) or not before(value_p, values + Capacity)) {
+        return Capacity;
+    }
+    return value_p - values;
+}
+
+/*
+ * Returns the Fibonacci heap address of the element at inputted
+ * address, following the record made when an inline element moved
+ */
+template <typename Key, typename Compare, typename ErrorPolicy, size_t Capacity>
+FibHeap_ElemAddr SmallFibHeap<Key, Compare, ErrorPolicy, Capacity>::heap_address(FibHeap_ElemAddr addr, const char *message)
+{
+    size_t slot = slot_of(addr);
+    if (slot == Capacity) {
+        return addr;
+    }
+    ErrorPolicy::check(slot < forward.size() and forward[slot] != nullptr, message);
+    return forward[slot];
+}
+
+/*
+ * Reports inputted error message if inputted slot holds no element
+ */
+template <typename Key, typename Compare, typename ErrorPolicy, size_t Capacity>
+void SmallFibHeap<Key, Compare, ErrorPolicy, Capacity>::check_slot(size_t slot, const char *message)
+{
+    ErrorPolicy::check(slot != Capacity and pos[slot] != FREE_SLOT, message);
+}
+
+/*
+ * Puts inputted slot at position p of the binary heap
+ */
+template <typename Key, typename Compare, typename ErrorPolicy, size_t Capacity>
+void SmallFibHeap<Key, Compare, ErrorPolicy, Capacity>::place(size_t p, uint8_t slot)
+{
+    order[p] = slot;
+    pos[slot] = p;
+}
+
+/*
+ * Moves the slot at position p up the binary heap until its parent is
+ * no greater
+ */
+template <typename Key, typename Compare, typename ErrorPolicy, size_t Capacity>
+void SmallFibHeap<Key, Compare, ErrorPolicy, Capacity>::sift_up(size_t p)
+{
+    uint8_t slot = order[p];
+    while (p > 0) {
+        size_t parent = (p - 1) / 2;
+        if (not comp(values[slot], values[order[parent]])) {
+            break;
+        }
+        place(p, order[parent]);
+        p = parent;
+    }
+    place(p, slot);
+}
+
+/*
+ * Moves the slot at position p down the binary heap until neither
+ * child is smaller
+ */
+template <typename Key, typename Compare, typename ErrorPolicy, size_t Capacity>
+void SmallFibHeap<Key, Compare, ErrorPolicy, Capacity>::sift_down(size_t p)
+{
+    uint8_t slot = order[p];
+    while (true) {
+        size_t child = 2 * p + 1;
+        if (child >= numInline) {
+            break;
+        }
+        if (child + 1 < numInline and comp(values[order[child + 1]], values[order[child]])) {
+            child++;
+        }
+        if (not comp(values[order[child]], values[slot])) {
+            break;
+        }
+        place(p, order[child]);
+        p = child;
+    }
+    place(p, slot);
+}
+
+/*
+ * Frees the slot at position p of the binary heap, filling the gap
+ * with the last slot of the heap
+ */
+template <typename Key, typename Compare, typename ErrorPolicy, size_t Capacity>
+void SmallFibHeap<Key, Compare, ErrorPolicy, Capacity>::remove_at(size_t p)
+{
+    uint8_t slot = order[p];
+    numInline--;
+    uint8_t last = order[numInline];
+    order[numInline] = slot;
+    pos[slot] = FREE_SLOT;
+    if (p < numInline) {
+        place(p, last);
+        sift_up(p);
+        sift_down(pos[last]);
+    }
+}
+
+/*
+ * Sets this heap's elements to copies of other's. The Fibonacci heap
+ * is copied only if it holds elements.
+ */
+template <typename Key, typename Compare, typename ErrorPolicy, size_t Capacity>
+void SmallFibHeap<Key, Compare, ErrorPolicy, Capacity>::copy_slots(const SmallFibHeap &other)
+{
+    for (size_t i = 0; i < Capacity; i++) {
+        order[i] = other.order[i];
+        pos[i] = other.pos[i];
+    }
+    numInline = other.numInline;
+    for (size_t p = 0; p < numInline; p++) {
+        values[order[p]] = other.values[order[p]];
+    }
+
+    if (other.promoted()) {
+        heap.reset(new Heap(*other.heap));
+    } else if (heap != nullptr) {
+        heap->clear();
+    }
+    forward.clear();
+}
@@ -0,0 +1,61 @@
+/*
+ * fib-heap-snapshot.h
+ *
+ * Interface for read-only access to a heap snapshot written by
+ * FibHeap::save, without loading it. The snapshot file is mapped into
+ * memory, so opening it takes constant time however large it is, and
+ * the minimum and any element's value can be read straight away while
+ * the heap itself is restored later, or in another thread.
+ *
+ * Elements are identified by their snapshot index (see
+ * FibHeap_SnapshotHeader in fib-heap.h), which restore() maps to
+ * addresses in the restored heap. The Payload and Index template
+ * parameters name the heap type the snapshot was saved by, as for
+ * FibHeap, and a snapshot saved by any other type is not opened.
+ *
+ * Uses mmap, so is only available on POSIX systems.
+ */
+
+#ifndef FIB_HEAP_SNAPSHOT_H
+#define FIB_HEAP_SNAPSHOT_H
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "fib-heap.h"
+
+template <typename Key = FibHeap_ElemType, typename Payload = void, typename Index = FibHeap_NoIndex>
+class FibHeapSnapshot {
+    public:
+        // Constructor maps the snapshot at inputted path; see isOpen()
+        explicit FibHeapSnapshot(const char *path);
+        ~FibHeapSnapshot();
+        FibHeapSnapshot(const FibHeapSnapshot &other) = delete;
+        FibHeapSnapshot &operator =(const FibHeapSnapshot &rhs) = delete;
+
+        // Retrieve information
+        bool isOpen() const;
+        bool isEmpty() const;
+        int size() const;
+        Key get_min() const;
+        Key get_value(size_t index) const;
+
+        // Rebuilds the snapshot's heap in a FibHeap of the same type
+        template <typename Heap>
+        bool restore(Heap &heap, std::vector<FibHeap_ElemAddr> *addrs_out = nullptr) const;
+
+    private:
+        // Mapped file (nullptr if not open), and its header and layout
+        const char *data;
+        size_t length;
+        FibHeap_SnapshotHeader header;
+        FibHeap_SnapshotLayout layout;
+
+        // Helper functions
+        void unmap();
+};
+
+#include "fib-heap-snapshot.tpp"
+
+#endif
@@ -0,0 +1,154 @@
+/*
+ * fib-heap-snapshot.tpp
+ *
+ * Implementation of read-only snapshot access declared in
+ * fib-heap-snapshot.h.
+ *
+ * This file is included at the bottom of fib-heap-snapshot.h and should not
+ * be compiled or included on its own.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+ * Constructor -- maps the snapshot file at inputted path. If the file
+ * cannot be mapped, or is not a snapshot of a heap with these key,
+ * payload and ID types, the snapshot is left closed and isOpen()
+ * returns false.
+ */
+template <typename Key, typename Payload, typename Index>
+FibHeapSnapshot<Key, Payload, Index>::FibHeapSnapshot(const char *path)
+{
+    data = nullptr;
+    length = 0;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+    struct stat info;
+    if (fstat(fd, &info) == 0 and info.st_size > 0) {
+        void *mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped != MAP_FAILED) {
+            data = (const char *)mapped;
+            length = info.st_size;
+        }
+    }
+    close(fd);
+    if (data == nullptr) {
+        return;
+    }
+
+    size_t payloadSize = 0;
+    if constexpr (not std::is_void<Payload>::value) {
+        payloadSize = sizeof(Payload);
+    }
+    size_t idSize = std::is_same<Index, FibHeap_NoIndex>::value ? 0 : sizeof(typename Index::IdType);
+    if (not FibHeap_read_snapshot_header(data, length, &header) or header.keySize != sizeof(Key) or
+        header.payloadSize != payloadSize or header.idSize != idSize or
+        (header.numElems > 0 and header.minIndex >= header.numElems)) {
+        unmap();
+        return;
+    }
+    layout = FibHeap_snapshot_layout(header);
+}
+
+// destructor -- unmaps the snapshot file
+template <typename Key, typename Payload, typename Index>
+FibHeapSnapshot<Key, Payload, Index>::~FibHeapSnapshot()
+{
+    unmap();
+}
+
+/*
+ * Returns whether the snapshot file was mapped successfully
+ */
+template <typename Key, typename Payload, typename Index>
+bool FibHeapSnapshot<Key, Payload, Index>::isOpen() const
+{
+    return data != nullptr;
+}
+
+/*
+ * Returns whether the snapshot holds no elements
+ */
+template <typename Key, typename Payload, typename Index>
+bool FibHeapSnapshot<Key, Payload, Index>::isEmpty() const
+{
+    return size() == 0;
+}
+
+/*
+ * Returns the number of elements in the snapshot
+ */
+template <typename Key, typename Payload, typename Index>
+int FibHeapSnapshot<Key, Payload, Index>::size() const
+{
+    return isOpen() ? (int)header.numElems : 0;
+}
+
+/*
+ * Retrieves the value of the minimum element of the snapshot
+ */
+template <typename Key, typename Payload, typename Index>
+Key FibHeapSnapshot<Key, Payload, Index>::get_min() const
+{
+    if (isEmpty()) {
+        std::cerr << "Snapshot is empty -- cannot get the minimum element" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    return get_value(header.minIndex);
+}
+
+/*
+ * Retrieves the value of the element with inputted snapshot index
+ */
+template <typename Key, typename Payload, typename Index>
+Key FibHeapSnapshot<Key, Payload, Index>::get_value(size_t index) const
+{
+    if (index >= (size_t)size()) {
+        std::cerr << "Cannot get the value of an element that is not in the snapshot" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    Key value;
+    std::memcpy(&value, data + layout.keys + index * sizeof(Key), sizeof(Key));
+    return value;
+}
+
+/*
+ * Replaces the contents of inputted heap with the heap saved in the
+ * snapshot, reading straight from the mapping. If addrs_out is not
+ * null, (*addrs_out)[i] is set to the address of the element with
+ * snapshot index i. Returns false if the snapshot is not open or was
+ * saved by a heap of a different type.
+ */
+template <typename Key, typename Payload, typename Index>
+template <typename Heap>
+bool FibHeapSnapshot<Key, Payload, Index>::restore(Heap &heap, std::vector<FibHeap_ElemAddr> *addrs_out) const
+{
+    if (not isOpen()) {
+        heap.clear();
+        return false;
+    }
+    return heap.load(data, length, addrs_out);
+}
+
+/*
+ * Unmaps the snapshot file if it is mapped
+ */
+template <typename Key, typename Payload, typename Index>
+void FibHeapSnapshot<Key, Payload, Index>::unmap()
+{
+    if (data != nullptr) {
+        munmap((void *)data, length);
+        data = nullptr;
+        length = 0;
+    }
+}
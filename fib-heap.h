@@ -16,6 +16,24 @@
  *    DELETE VALUE - O(log n) amortized
  *    GET VALUE FROM ADDRESS - O(1)
  *    GET ADDRESS FROM VALUE - O(n)
+ *    GET ADDRESS FROM ID - O(1) (expected O(1) with FibHeap_HashIndex)
+ *    MERGE TWO HEAPS - O(1)
+ *
+ * Inserts can optionally be buffered (see set_insert_buffer): buffered 
+ * elements are only linked into trees, all at once, when the minimum 
+ * is next needed. Their addresses are valid as soon as they are inserted.
+ *
+ * remove_min normally links every root of equal degree before it 
+ * returns, which after n inserts is one pause of O(n) time. With a link 
+ * budget (see set_link_budget), insert and remove_min each link at most 
+ * that many trees and leave the rest for later calls, so the work is 
+ * spread over the calls that cause it and no single one is long.
+ *
+ * Heaps of integer keys whose removed minimums never decrease, as in 
+ * Dijkstra's algorithm, can be made monotone (see set_monotone): keys 
+ * in a window just above the last minimum removed are then kept in 
+ * buckets indexed by key, which are inserted into, decreased and removed 
+ * from in constant time, and only keys beyond the window go into trees.
  * 
  * FibHeap_ElemAddr is a type given to the client to allow for storing of 
  * element addresses as desired. This could be useful for implementing 
@@ -24,98 +42,728 @@
  * In order for this to work, the client should NOT modify anything pointed 
  * to by the address directly; addresses will only be used as handles to 
  * be passed back into functions of this class. 
+ *
+ * An address is only valid until its element is removed, after which 
+ * the node may be reused. Where a client may still hold addresses of 
+ * removed elements, checked_address gives a FibHeap_CheckedAddr, which 
+ * also records the generation of the node (the number of times it has 
+ * been reused). Functions given a checked address compare the two 
+ * generations first, so the address of a removed element is rejected 
+ * rather than followed. Generations are 32 bits, so a node would have 
+ * to be reused over four billion times for a stale address to pass 
+ * again. Checked addresses are invalidated, undetectably, by clear(), 
+ * assignment and destruction, which release the nodes' memory.
+ *
+ * FibHeap is a header-only template with the following parameters:
+ *    Key = type of the values ordered by the heap (FibHeap_ElemType by default)
+ *    Compare = ordering of values; Compare(a, b) is true if a should come 
+ *              out of the heap before b (std::less by default, giving a 
+ *              min heap; see MaxFibHeap for a max heap)
+ *    Payload = optional data stored next to each value in its node, such 
+ *              as the vertex a distance belongs to (void for no payload)
+ *    Index = optional index from element IDs to addresses, giving O(1) 
+ *            lookups by ID (FibHeap_NoIndex by default; see 
+ *            FibHeap_DenseIndex and FibHeap_HashIndex below)
+ *    ErrorPolicy = what happens when a function is misused, such as 
+ *                  removing from an empty heap (FibHeap_ExitOnError by 
+ *                  default; see FibHeap_AssertOnError and FibHeap_Unchecked 
+ *                  below)
+ * Throughout this interface, "minimum" refers to the element that comes 
+ * first under Compare.
+ *
+ * Compiling with FIB_HEAP_STATS defined makes every heap count the work 
+ * it does (see FibHeap_Stats), readable through stats(). Without it the 
+ * counters and stats() do not exist and cost nothing.
  */
 
-#include <vector>
+#ifndef FIB_HEAP_H
+#define FIB_HEAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 typedef int FibHeap_ElemType;
 typedef void *FibHeap_ElemAddr;
 
+/* Address of an element along with the generation of its node, so that 
+ * addresses of removed elements can be detected (see checked_address)
+ */
+struct FibHeap_CheckedAddr {
+    FibHeap_ElemAddr addr;
+    uint32_t generation;
+};
+
+// Stand-in payload type for heaps declared without a payload
+struct FibHeap_NoPayload {};
+
+// Storage for a node's payload; empty if the heap has no payload
+template <typename Payload>
+struct FibHeap_PayloadHolder {
+    Payload payload;
+};
+template <>
+struct FibHeap_PayloadHolder<void> {};
+
+/*
+ * Index policies map element IDs to the addresses of their nodes. An ID 
+ * is given when inserting with insert_with_id, and the heap keeps the 
+ * index up to date as elements are removed. Each policy provides:
+ *    IdType = type of element IDs
+ *    find(id) = address of element with ID, or nullptr if not in heap
+ *    set(id, addr), erase(id), clear(), swap(other)
+ */
+
+// No index (the default); IDs cannot be used
+struct FibHeap_NoIndex {
+    typedef size_t IdType;
+};
+
+// Index for small non-negative integer IDs, such as vertex numbers, 
+// stored in an array indexed by ID
+struct FibHeap_DenseIndex {
+    typedef size_t IdType;
+
+    FibHeap_ElemAddr find(size_t id) const
+    {
+        return id < addrs.size() ? addrs[id] : nullptr;
+    }
+    void set(size_t id, FibHeap_ElemAddr addr)
+    {
+        if (id >= addrs.size()) {
+            addrs.resize(id + 1, nullptr);
+        }
+        addrs[id] = addr;
+    }
+    void erase(size_t id) { addrs[id] = nullptr; }
+    void clear() { addrs.clear(); }
+    void swap(FibHeap_DenseIndex &other) { addrs.swap(other.addrs); }
+
+    private:
+        std::vector<FibHeap_ElemAddr> addrs;
+};
+
+// Index for arbitrary IDs, stored in a hash table
+template <typename Id, typename Hash = std::hash<Id>, typename Equal = std::equal_to<Id>>
+struct FibHeap_HashIndex {
+    typedef Id IdType;
+
+    FibHeap_ElemAddr find(const Id &id) const
+    {
+        auto itr = addrs.find(id);
+        return itr != addrs.end() ? itr->second : nullptr;
+    }
+    void set(const Id &id, FibHeap_ElemAddr addr) { addrs[id] = addr; }
+    void erase(const Id &id) { addrs.erase(id); }
+    void clear() { addrs.clear(); }
+    void swap(FibHeap_HashIndex &other) { addrs.swap(other.addrs); }
+
+    private:
+        std::unordered_map<Id, FibHeap_ElemAddr, Hash, Equal> addrs;
+};
+
+#ifdef FIB_HEAP_STATS
+/*
+ * Counts of the work done by one heap since it was created or since 
+ * reset_stats() was called:
+ * links = trees linked below another tree while consolidating
+ * cuts = nodes cut from their parent and made roots, including 
+ *        cascading cuts
+ * cascadingCuts = cuts of a loser parent after one of its children 
+ *                 was cut
+ * maxCascadeDepth = most cascading cuts caused by a single cut
+ * consolidations = number of times the ring of roots was consolidated
+ * rootsConsolidated = total roots seen by those consolidations; divide 
+ *                     by consolidations for the average ring length
+ * maxRootListLength = longest ring of roots seen by a consolidation
+ * peakMaxDegree = largest number of children any node has had
+ * nodeAllocs, nodeFrees = nodes handed out and given back
+ * slabAllocs = slabs of node storage allocated
+ */
+struct FibHeap_Stats {
+    size_t links;
+    size_t cuts;
+    size_t cascadingCuts;
+    size_t maxCascadeDepth;
+    size_t consolidations;
+    size_t rootsConsolidated;
+    size_t maxRootListLength;
+    size_t peakMaxDegree;
+    size_t nodeAllocs;
+    size_t nodeFrees;
+    size_t slabAllocs;
+};
+
+// Runs a statement that updates stats only when stats are compiled in
+#define FIB_HEAP_STAT(stmt) stmt
+#else
+#define FIB_HEAP_STAT(stmt)
+#endif
+
+// Compiler hints used by the error policies and the hot loops
+#if defined(__GNUC__)
+#define FIB_HEAP_UNLIKELY(cond) __builtin_expect(!!(cond), 0)
+#define FIB_HEAP_ASSUME(cond) do { if (not (cond)) __builtin_unreachable(); } while (0)
+#define FIB_HEAP_COLD __attribute__((cold, noinline))
+#define FIB_HEAP_PREFETCH(addr) __builtin_prefetch(addr)
+#elif defined(_MSC_VER)
+#define FIB_HEAP_UNLIKELY(cond) (cond)
+#define FIB_HEAP_ASSUME(cond) __assume(cond)
+#define FIB_HEAP_COLD __declspec(noinline)
+#define FIB_HEAP_PREFETCH(addr) ((void)0)
+#else
+#define FIB_HEAP_UNLIKELY(cond) (cond)
+#define FIB_HEAP_ASSUME(cond) ((void)0)
+#define FIB_HEAP_COLD
+#define FIB_HEAP_PREFETCH(addr) ((void)0)
+#endif
+
+/*
+ * Error policies. Each has a check(ok, message) function, which the heap 
+ * calls wherever it could be misused (an empty heap, a null address, a 
+ * value that does not decrease, ...) with ok false if it was misused:
+ *    FibHeap_ExitOnError = print message to cerr and exit, as FibHeap 
+ *                          always has
+ *    FibHeap_AssertOnError = print message and abort() in debug builds, 
+ *                            so a debugger stops at the misuse; no checks 
+ *                            at all when NDEBUG is defined
+ *    FibHeap_Unchecked = no checks; misuse is undefined behavior, and the 
+ *                        compiler is told it never happens
+ * The printing is kept out of line, so a passing check costs a single 
+ * predicted branch. try_get_min and try_remove_min report an empty heap 
+ * under every policy, by returning an empty std::optional.
+ */
+struct FibHeap_ExitOnError {
+    static void check(bool ok, const char *message)
+    {
+        if (FIB_HEAP_UNLIKELY(not ok)) {
+            fail(message);
+        }
+    }
+    [[noreturn]] FIB_HEAP_COLD static void fail(const char *message)
+    {
+        std::cerr << message << std::endl;
+        exit(EXIT_FAILURE);
+    }
+};
+
+struct FibHeap_AssertOnError {
+    static void check(bool ok, const char *message)
+    {
+#ifndef NDEBUG
+        if (FIB_HEAP_UNLIKELY(not ok)) {
+            fail(message);
+        }
+#else
+        (void)ok;
+        (void)message;
+#endif
+    }
+    [[noreturn]] FIB_HEAP_COLD static void fail(const char *message)
+    {
+        std::cerr << message << std::endl;
+        abort();
+    }
+};
+
+struct FibHeap_Unchecked {
+    static void check(bool ok, const char *)
+    {
+        FIB_HEAP_ASSUME(ok);
+    }
+};
+
+/*
+ * Snapshots. save() writes a heap to a file in a relocatable binary 
+ * format, and load() rebuilds exactly the same forest from it without 
+ * comparing any keys. Elements are numbered in a snapshot by a 
+ * breadth-first walk of the forest: the roots in ring order, then each 
+ * element's children in list order, so every element comes after its 
+ * parent. An element's number is its snapshot index, and handle tables 
+ * can be carried over a save and load by snapshot index (see the 
+ * order_out and addrs_out arguments). The header is followed by these 
+ * arrays, each starting at a multiple of 64 bytes:
+ *    keys = value of each element (numElems * keySize bytes)
+ *    parents = snapshot index of each element's parent (uint32_t); 
+ *              FibHeap_SnapshotRoot for roots
+ *    degrees = number of children of each element (uint16_t)
+ *    losers = loser mark of each element (uint8_t)
+ *    payloads = payload of each element, if the heap has a payload type
+ *    ids, hasIds = ID of each element and whether it has one (uint8_t), 
+ *                  if the heap has an index
+ * Keys, payloads and IDs are stored as raw bytes, so they must be 
+ * trivially copyable, and a snapshot can only be read back on a machine 
+ * with the same byte order and type sizes. The header records those 
+ * sizes and load() rejects files that do not match. fib-heap-snapshot.h 
+ * maps a snapshot into memory to read its minimum without loading it.
+ */
+struct FibHeap_SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t keySize;
+    uint32_t payloadSize;
+    uint32_t idSize;
+    uint64_t numElems;
+    uint64_t minIndex;
+};
+
+// Byte offsets of the arrays of a snapshot from the start of the file, 
+// and total size of the file
+struct FibHeap_SnapshotLayout {
+    size_t keys;
+    size_t parents;
+    size_t degrees;
+    size_t losers;
+    size_t payloads;
+    size_t ids;
+    size_t hasIds;
+    size_t total;
+};
+
+const char FibHeap_SnapshotMagic[8] = "FIBHEAP";
+const uint32_t FibHeap_SnapshotVersion = 1;
+const uint32_t FibHeap_SnapshotRoot = UINT32_MAX;
+
+inline FibHeap_SnapshotLayout FibHeap_snapshot_layout(const FibHeap_SnapshotHeader &header);
+inline bool FibHeap_read_snapshot_header(const void *data, size_t size, FibHeap_SnapshotHeader *header);
+
+// Storage for a node's ID; empty if the heap has no index
+template <typename Index>
+struct FibHeap_IdHolder {
+    typename Index::IdType id;
+    bool hasId = false;
+};
+template <>
+struct FibHeap_IdHolder<FibHeap_NoIndex> {};
+
+template <typename Key = FibHeap_ElemType, typename Compare = std::less<Key>, 
+          typename Payload = void, typename Index = FibHeap_NoIndex, 
+          typename ErrorPolicy = FibHeap_ExitOnError>
 class FibHeap {
     public:
-        // Constructors, Destructor, Assignment Operator Overload
-        FibHeap();
-        FibHeap(FibHeap_ElemType *arr, int size);
+        typedef typename std::conditional<std::is_void<Payload>::value, 
+                                          FibHeap_NoPayload, Payload>::type PayloadType;
+        typedef typename Index::IdType IdType;
+
+        // Default number of inserts buffered by set_insert_buffer()
+        static const size_t DEFAULT_INSERT_BUFFER = 1024;
+
+        // Default number of links per call set by set_link_budget()
+        static const size_t DEFAULT_LINK_BUDGET = 64;
+
+        // Default number of buckets set by set_monotone()
+        static const size_t DEFAULT_MONOTONE_WINDOW = 1024;
+
+        // Constructors, Destructor, Assignment Operator Overloads
+        explicit FibHeap(const Compare &comp = Compare());
+        FibHeap(Key *arr, int size, const Compare &comp = Compare());
+        template <typename ForwardIt>
+        FibHeap(ForwardIt first, ForwardIt last, FibHeap_ElemAddr *addrs_out = nullptr, 
+                const Compare &comp = Compare());
         ~FibHeap();
-        FibHeap(FibHeap &other);
-        FibHeap &operator =(FibHeap &rhs);
+        FibHeap(const FibHeap &other);
+        FibHeap &operator =(const FibHeap &rhs);
+        FibHeap(FibHeap &&other) noexcept;
+        FibHeap &operator =(FibHeap &&rhs) noexcept;
+        void swap(FibHeap &other) noexcept;
 
         // Retrieve information
-        bool isEmpty();
-        int size();
-        FibHeap_ElemType get_min();
-        FibHeap_ElemType get_value(FibHeap_ElemAddr addr);
-        FibHeap_ElemAddr get_address(FibHeap_ElemType value);
+        bool isEmpty() const;
+        int size() const;
+        Key get_min();
+        std::optional<Key> try_get_min();
+        Key get_value(FibHeap_ElemAddr addr);
+        FibHeap_ElemAddr get_address(const Key &value);
+
+        // Retrieve payloads (only for heaps declared with a payload type)
+        PayloadType &get_payload(FibHeap_ElemAddr addr);
+        PayloadType &get_min_payload();
+        
+        // Look up elements by ID (only for heaps declared with an index)
+        bool contains(const IdType &id) const;
+        FibHeap_ElemAddr get_address_by_id(const IdType &id) const;
+        IdType get_id(FibHeap_ElemAddr addr);
         
         // Modify fibonacci heap
-        FibHeap_ElemAddr insert(FibHeap_ElemType value);
-        FibHeap_ElemType remove_min();
-        void decrease_val(FibHeap_ElemAddr addr, FibHeap_ElemType value);
+        FibHeap_ElemAddr insert(const Key &value);
+        FibHeap_ElemAddr insert(const Key &value, const PayloadType &payload);
+        FibHeap_ElemAddr insert_with_id(const IdType &id, const Key &value);
+        template <typename ForwardIt>
+        void insert_range(ForwardIt first, ForwardIt last, FibHeap_ElemAddr *addrs_out = nullptr);
+        Key remove_min();
+        Key remove_min(PayloadType *payload_p);
+        std::optional<Key> try_remove_min();
+        void decrease_val(FibHeap_ElemAddr addr, const Key &value);
+        template <typename ForwardIt>
+        void decrease_many(ForwardIt first, ForwardIt last);
+        void increase_val(FibHeap_ElemAddr addr, const Key &value);
+        void decrease_val_by_id(const IdType &id, const Key &value);
         void delete_elem(FibHeap_ElemAddr addr);
-        void change_val(FibHeap_ElemAddr *addr_p, FibHeap_ElemType value);
+        void change_val(FibHeap_ElemAddr *addr_p, const Key &value);
         void merge(FibHeap &other);
+        void merge(FibHeap &&other);
         void clear();
+        void set_insert_buffer(size_t capacity = DEFAULT_INSERT_BUFFER);
+        void set_link_budget(size_t maxLinks = DEFAULT_LINK_BUDGET);
+        void set_monotone(size_t window = DEFAULT_MONOTONE_WINDOW);
+
+        // Use addresses that detect removal of their element (see 
+        // FibHeap_CheckedAddr); the try_ functions return false, or an 
+        // empty optional, for the address of a removed element
+        FibHeap_CheckedAddr checked_address(FibHeap_ElemAddr addr);
+        bool holds(FibHeap_CheckedAddr handle) const;
+        Key get_value(FibHeap_CheckedAddr handle);
+        std::optional<Key> try_get_value(FibHeap_CheckedAddr handle);
+        void decrease_val(FibHeap_CheckedAddr handle, const Key &value);
+        bool try_decrease_val(FibHeap_CheckedAddr handle, const Key &value);
+        void delete_elem(FibHeap_CheckedAddr handle);
+        bool try_delete_elem(FibHeap_CheckedAddr handle);
+
+        // Copy or empty large heaps using several threads; numThreads = 0 
+        // uses the machine's hardware concurrency
+        FibHeap parallel_copy(size_t numThreads = 0) const;
+        void parallel_clear(size_t numThreads = 0);
+
+        // Remove or look at the k smallest elements, in sorted order
+        class Drain;
+        Drain drain();
+        template <typename OutputIt>
+        OutputIt pop_k(size_t k, OutputIt out);
+        template <typename OutputIt>
+        OutputIt peek_k(size_t k, OutputIt out);
+
+        // Save to and restore from snapshot files (see FibHeap_SnapshotHeader); 
+        // these return false if the file cannot be written or read
+        bool save(const char *path, std::vector<FibHeap_ElemAddr> *order_out = nullptr);
+        bool load(const char *path, std::vector<FibHeap_ElemAddr> *addrs_out = nullptr);
+        bool load(const void *data, size_t size, std::vector<FibHeap_ElemAddr> *addrs_out = nullptr);
 
         // Print contents of fibonacci heap
         void print();
 
+#ifdef FIB_HEAP_STATS
+        // Counts of work done by this heap
+        const FibHeap_Stats &stats() const;
+        void reset_stats();
+#endif
+
         // Checks if heap is valid, i.e. does not violate internal invariants 
         // (should always return true unless there is an implementation bug)
         bool valid();
 
     private:
         /* A node in the fibonacci heap storing an element: 
+         * generation = number of times the node's storage has been freed; 
+         *              kept first, where a FreeNode keeps it too, so that 
+         *              it outlives the node
          * value = element stored in node
+         * numChildren = number of children current node has
          * loser = has node lost a child?
+         * left, right = neighbors in the ring of roots if node is a root, 
+         *               or in parent's circular list of children otherwise
+         * child = pointer to any one of node's children; nullptr if none
          * parent = pointer to node's parent in tree; nullptr if root
-         * childIndex = index of node in parent's array of children; -1 if root
-         * numChildren = number of children current node has
+         * The fields read for every root by consolidate (value, numChildren 
+         * and right) come first, in NodeCore, so that the payload and ID 
+         * are laid out after them and never push them apart. For int keys 
+         * a node takes 48 bytes, and its first 32 bytes, holding value, 
+         * numChildren and both sibling links, fall in one cache line for 
+         * three nodes out of four. A degree never exceeds 1.44 log2(n), 
+         * which is under 50 for any heap size, so 8 bits is plenty for 
+         * numChildren.
          */
-        struct Node {
-            FibHeap_ElemType value;
+        struct Node;
+        struct NodeCore {
+            explicit NodeCore(const Key &value) : value(value) {}
 
+            uint32_t generation;
+            uint8_t numChildren;
             bool loser;
+            Key value;
+
+            Node *left;
+            Node *right;
+            Node *child;
             Node *parent;
-            int childIndex;
-            std::vector<Node *> children;
-            int numChildren;
         };
-
-        // Stores pointers to roots of trees in a ring structure
-        struct RingNode {
-            Node *root;
-            RingNode *left;
-            RingNode *right;
+        struct Node : NodeCore, FibHeap_PayloadHolder<Payload>, FibHeap_IdHolder<Index> {
+            explicit Node(const Key &value) : NodeCore(value) {}
         };
         
-        // Fibonacci heap data members
-        RingNode *front;
-        RingNode *min;
+        // Ordering of values; an empty comparator such as std::less is 
+        // inlined at each comparison and costs nothing at runtime
+        Compare comp;
+
+        // Index from element IDs to nodes, if the heap has one
+        static constexpr bool indexed = not std::is_same<Index, FibHeap_NoIndex>::value;
+        Index index;
+
+        // A node waiting to be visited by a sorted walk of the heap. Its 
+        // value is copied in so that ordering candidates does not have to 
+        // read the nodes, which are scattered in memory.
+        struct Candidate {
+            Key value;
+            Node *node;
+        };
+        // Orders candidates so that std heap algorithms keep the smallest 
+        // value on top
+        struct CandidateOrder {
+            const Compare *comp;
+            bool operator()(const Candidate &a, const Candidate &b) const { return (*comp)(b.value, a.value); }
+        };
+
+        // Fibonacci heap data members. Roots of trees are linked directly 
+        // to each other in a ring structure through their left/right pointers
+        Node *front;
+        Node *min;
         int numElems;
         size_t maxDegree;
 
-        // Map between tree roots and ringnodes pointing to them
-        std::unordered_map<Node *, RingNode *> roots;
+        // Scratch table used by remove_min to find trees of equal degree. 
+        // It is kept between calls and only grows when the number of 
+        // elements passes degreeTableLimit, so consolidating never allocates.
+        std::vector<Node *> degreeTable;
+        size_t degreeTableLimit;
+
+        /* Trees are only linked a few at a time if there is a link budget. 
+         * Between calls, the degree table then holds the roots that have 
+         * been linked already, at most one per degree, and backlog holds 
+         * every other root; min is kept exact as a root of either. 
+         * linkBudget = most links made by one call (0 if there is no 
+         * budget, in which case the table is empty between calls and 
+         * backlog is unused).
+         */
+        std::vector<Node *> backlog;
+        size_t linkBudget;
+
+        /* Buckets for keys just above the last minimum removed, if the heap 
+         * is monotone (only possible for integer keys ordered by std::less). 
+         * A bucketed node is in no tree: it has no parent, is marked as a 
+         * loser (which roots never are), and is linked through left/right 
+         * into a ring with the other nodes of its bucket. min is the 
+         * minimum of the trees only.
+         * bucketFloor = largest minimum removed so far; keys from it up to 
+         *               bucketFloor + buckets.size() - 1 may be bucketed, 
+         *               key k in bucket k % buckets.size(), so all nodes 
+         *               in a bucket hold the same key
+         * bucketLow = where to start looking for the smallest bucketed 
+         *             key: inside the window and no larger than any 
+         *             bucketed key, if numBucketed > 0
+         */
+        static constexpr bool bucketable = std::is_integral<Key>::value and 
+                                           not std::is_same<Key, bool>::value and 
+                                           std::is_same<Compare, std::less<Key>>::value;
+        typedef typename std::conditional<bucketable, Key, long long>::type BucketKey;
+        std::vector<Node *> buckets;
+        BucketKey bucketFloor;
+        BucketKey bucketLow;
+        size_t numBucketed;
+
+        /* Nodes are carved out of large slabs owned by the heap instead of 
+         * being allocated one at a time. Nodes freed by remove_min or 
+         * delete_elem are kept on a free list and reused before slab space 
+         * is handed out; all slabs are released together by clear().
+         * used = number of nodes handed out from the slab so far
+         */
+        struct Slab {
+            Slab *next;
+            Node *nodes;
+            size_t capacity;
+            size_t used;
+        };
+        struct FreeNode {
+            uint32_t generation;
+            FreeNode *next;
+        };
+        static const size_t MIN_SLAB_NODES = 64;
+        static const size_t MAX_SLAB_NODES = 1 << 16;
+
+        // Heaps with fewer elements than this are copied and cleared by 
+        // one thread, as starting threads would cost more than it saves
+        static const size_t MIN_PARALLEL_ELEMS = 1 << 14;
+
+        /* Inserts waiting to be linked into trees, if inserts are buffered. 
+         * Buffered nodes are in no tree and have null left/right pointers, 
+         * which is how they are told apart from nodes in the ring or in a 
+         * tree. pendingLimit = most inserts buffered before they are 
+         * linked (0 if inserts are not buffered).
+         */
+        std::vector<Node *> pending;
+        size_t pendingLimit;
+
+        // Slab nodes are handed out from the front slab; lastSlab and 
+        // lastFreeNode let merge splice in another heap's storage
+        Slab *slabs;
+        Slab *lastSlab;
+        FreeNode *freeNodes;
+        FreeNode *lastFreeNode;
+
+#ifdef FIB_HEAP_STATS
+        FibHeap_Stats statistics = FibHeap_Stats();
+#endif
 
         // Helper functions
-        Node *newNode(FibHeap_ElemType value);
+        Node *newNode(const Key &value);
+        void free_node(Node *node);
+        void reserve_nodes(size_t n);
+        void add_slab(size_t min_capacity = 0);
+        void release_slabs();
+        void splice_slabs(FibHeap &other);
         void delete_subtree(Node *root);
-        Node *copy_subtree(Node *root);
-        RingNode *merge_trees(RingNode *r_tree1, RingNode *r_tree2);
+        Node *copy_subtree(const Node *root);
+        Node *copy_node(const Node *node);
+        template <typename NodePtr>
+        static NodePtr next_in_subtree(NodePtr node, NodePtr root, bool descend);
+        void copy_payload(Node *dest, const Node *src);
+        void copy_id(Node *dest, const Node *src);
+        void merge_index(FibHeap &other);
+        Node *merge_trees(Node *tree1, Node *tree2);
+        void consolidate();
+        void reserve_degree_table(size_t n);
+        static size_t degree_table_size(size_t n, size_t *limit_out);
+        void link_backlog(size_t maxLinks);
+        void restore_min();
+        void unsettle(Node *root);
+        void forget_root(Node *root);
+        void forget_settled();
+        Key remove_tree_min();
+        Node *top();
+        static bool in_bucket(const Node *node);
+        bool bucket_fits(const Key &value) const;
+        size_t bucket_of(const Key &value) const;
+        void bucket_insert(Node *node);
+        void bucket_remove(Node *node);
+        void move_bucketed(Node *node, const Key &value);
+        void raise_floor(const Key &value);
+        void flush_buckets();
+        void copy_buckets(const FibHeap &other);
         void add_root(Node *root);
-        void remove_ringnode(RingNode *ringNode);
-        void copy_instance(FibHeap &other);
-        Node *find_in_subtree(Node *node, FibHeap_ElemType value);
+        void link_root(Node *root);
+        void splice_roots(Node *otherFront, Node *otherMin);
+        void remove_root(Node *root);
+        void cut_to_root(Node *node);
+        void link_child(Node *parent, Node *child);
+        void cut_child(Node *parent, Node *child);
+        void copy_instance(const FibHeap &other);
+        void collect_roots(std::vector<Node *> &roots, std::vector<size_t> &order) const;
+        static size_t parallel_threads(size_t requested, size_t numTasks, size_t numElems);
+        template <typename Work>
+        static void run_parallel(size_t numThreads, size_t numTasks, Work work);
+        void buffer_insert(Node *node);
+        void flush_pending();
+        void link_pending();
+        void seed_candidates(std::vector<Candidate> &candidates);
+        Node *next_candidate(std::vector<Candidate> &candidates);
+        void remove_visited(std::vector<Node *> &visited, std::vector<Candidate> &candidates);
+        FibHeap_SnapshotHeader snapshot_header(size_t count, size_t minIndex) const;
+        template <typename T, typename Get>
+        static void write_array(std::ostream &out, size_t *pos, size_t offset, size_t count, Get get);
+        Node *find_in_subtree(Node *root, const Key &value);
 
         // Helper functions for printing aspects of the fibonacci heap
         void print_subtree(Node *root);
         void print_node(Node *node);
         void print_value(Node *node);
-        void print_values(std::vector<Node *> nodes);
+        void print_children(Node *node);
         void print_bool(bool tf);
 
         // Helper functions for checking if heap is valid
-        bool valid_ringnode(RingNode *ringnode, int *countElems);
-        bool valid_subtree(Node *node, int *countElems, bool is_root);
-};
\ No newline at end of file
+        bool valid_backlog();
+        bool valid_buckets(int *countElems);
+        bool valid_root(Node *root, int *countElems);
+        bool valid_subtree(Node *root, int *countElems);
+};
+
+/*
+ * A range over the elements of a heap in sorted order, returned by 
+ * FibHeap::drain(). The heap is consolidated once when the range is made; 
+ * after that, each step finds the next element with a small heap of 
+ * candidates (the roots, then the children of each element passed), 
+ * without changing the heap. Elements stepped past are removed from the 
+ * heap all at once, followed by a single consolidation, when the range is 
+ * destroyed. Reading an element does not step past it, so leaving a loop 
+ * early with break keeps the element being looked at:
+ *    for (Key value : heap.drain()) { if (value > limit) break; ... }
+ * The heap must not be used in any other way while the range exists.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+class FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::Drain {
+    public:
+        class iterator {
+            public:
+                typedef std::input_iterator_tag iterator_category;
+                typedef Key value_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef const Key *pointer;
+                typedef const Key &reference;
+
+                explicit iterator(Drain *range = nullptr) : range(range) {}
+                const Key &operator *() const { return range->candidates.front().value; }
+                const Key *operator ->() const { return &range->candidates.front().value; }
+                iterator &operator ++()
+                {
+                    range->visited.push_back(range->heap->next_candidate(range->candidates));
+                    return *this;
+                }
+                struct postfix_proxy {
+                    Key value;
+                    const Key &operator *() const { return value; }
+                };
+                postfix_proxy operator ++(int)
+                {
+                    postfix_proxy old = {**this};
+                    ++*this;
+                    return old;
+                }
+                bool operator ==(const iterator &other) const { return done() == other.done(); }
+                bool operator !=(const iterator &other) const { return not (*this == other); }
+
+            private:
+                Drain *range;
+                bool done() const { return range == nullptr or range->candidates.empty(); }
+        };
+
+        explicit Drain(FibHeap &heap);
+        ~Drain();
+        Drain(Drain &&other) noexcept;
+        Drain(const Drain &other) = delete;
+        Drain &operator =(const Drain &rhs) = delete;
+
+        iterator begin() { return iterator(this); }
+        iterator end() { return iterator(); }
+
+    private:
+        // visited = elements stepped past, to be removed from heap
+        FibHeap *heap;
+        std::vector<Candidate> candidates;
+        std::vector<Node *> visited;
+};
+
+// Deduce the key type of heaps built from a range of elements
+template <typename ForwardIt>
+FibHeap(ForwardIt, ForwardIt) -> FibHeap<typename std::iterator_traits<ForwardIt>::value_type>;
+template <typename ForwardIt>
+FibHeap(ForwardIt, ForwardIt, FibHeap_ElemAddr *) 
+    -> FibHeap<typename std::iterator_traits<ForwardIt>::value_type>;
+
+// Exchanges contents of two fibonacci heaps in constant time
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void swap(FibHeap<Key, Compare, Payload, Index, ErrorPolicy> &a, FibHeap<Key, Compare, Payload, Index, ErrorPolicy> &b) noexcept
+{
+    a.swap(b);
+}
+
+// Fibonacci heap that removes the largest element first
+template <typename Key = FibHeap_ElemType, typename Payload = void>
+using MaxFibHeap = FibHeap<Key, std::greater<Key>, Payload>;
+
+#include "fib-heap.tpp"
+
+#endif
@@ -0,0 +1,3198 @@
+/*
+ * fib-heap.tpp
+ *
+ * By Randy Dang
+ * Written December 2021 - January 2022
+ * 
+ * Implementation for the Fibonacci Heap data structure. Useful for 
+ * operations such as Dijkstra's Algorithm to allow for constant 
+ * amortized time to decrease a value
+ *
+ * This file is included at the bottom of fib-heap.h and should not 
+ * be compiled or included on its own.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <queue>
+#include <thread>
+#include <utility>
+
+/*
+ * Returns the layout of a snapshot described by inputted header. Each 
+ * array starts on a 64-byte boundary so that a mapped snapshot's arrays 
+ * are aligned. Headers come from files, so every size is checked for 
+ * overflow; if any offset does not fit in a size_t, total is SIZE_MAX, 
+ * which no snapshot in memory can hold.
+ */
+inline FibHeap_SnapshotLayout FibHeap_snapshot_layout(const FibHeap_SnapshotHeader &header)
+{
+    bool overflow = header.numElems > SIZE_MAX;
+    size_t count = overflow ? 0 : header.numElems;
+
+    // Returns offset plus the size of count elements of inputted size
+    auto after = [&](size_t offset, size_t elemSize) {
+        if (elemSize != 0 and count > (SIZE_MAX - offset) / elemSize) {
+            overflow = true;
+            return offset;
+        }
+        return offset + count * elemSize;
+    };
+    auto align = [&](size_t offset) {
+        if (offset > SIZE_MAX - 63) {
+            overflow = true;
+            return offset;
+        }
+        return (offset + 63) / 64 * 64;
+    };
+
+    FibHeap_SnapshotLayout layout;
+    layout.keys = align(sizeof(FibHeap_SnapshotHeader));
+    layout.parents = align(after(layout.keys, header.keySize));
+    layout.degrees = align(after(layout.parents, sizeof(uint32_t)));
+    layout.losers = align(after(layout.degrees, sizeof(uint16_t)));
+    layout.payloads = align(after(layout.losers, 1));
+    layout.ids = align(after(layout.payloads, header.payloadSize));
+    layout.hasIds = align(after(layout.ids, header.idSize));
+
+    // The file ends with the last array present
+    if (header.idSize != 0) {
+        layout.total = after(layout.hasIds, 1);
+    } else if (header.payloadSize != 0) {
+        layout.total = after(layout.payloads, header.payloadSize);
+    } else {
+        layout.total = after(layout.losers, 1);
+    }
+    if (overflow) {
+        layout.total = SIZE_MAX;
+    }
+    return layout;
+}
+
+/*
+ * Copies the header of the snapshot held in inputted memory into 
+ * *header. Returns false if the memory does not hold a complete 
+ * snapshot of the current version, or the snapshot has more elements 
+ * than a heap can hold (its size is reported as an int).
+ */
+inline bool FibHeap_read_snapshot_header(const void *data, size_t size, FibHeap_SnapshotHeader *header)
+{
+    if (data == nullptr or size < sizeof(FibHeap_SnapshotHeader)) {
+        return false;
+    }
+    std::memcpy(header, data, sizeof(FibHeap_SnapshotHeader));
+    return std::memcmp(header->magic, FibHeap_SnapshotMagic, sizeof(header->magic)) == 0 and 
+           header->version == FibHeap_SnapshotVersion and 
+           header->numElems < FibHeap_SnapshotRoot and header->numElems <= (uint64_t)INT_MAX and 
+           FibHeap_snapshot_layout(*header).total <= size;
+}
+
+// default constructor; optionally takes an instance of the comparator
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::FibHeap(const Compare &comp) : comp(comp)
+{
+    front = nullptr;
+    min = nullptr;
+    numElems = 0;
+    maxDegree = 1;
+    degreeTableLimit = 0;
+    linkBudget = 0;
+    bucketFloor = BucketKey();
+    bucketLow = BucketKey();
+    numBucketed = 0;
+    pendingLimit = 0;
+
+    slabs = nullptr;
+    lastSlab = nullptr;
+    freeNodes = nullptr;
+    lastFreeNode = nullptr;
+}
+
+/* 
+ * Secondary constructor; constructs a 
+ * fibonacci heap using elements in inputted
+ * array in linear time. Inputted size should 
+ * be the size of the array.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::FibHeap(Key *arr, int size, const Compare &comp) : comp(comp)
+{
+    ErrorPolicy::check(arr != nullptr, "Cannot make a fibonacci heap out of a null array.");
+    ErrorPolicy::check(size >= 0, "Cannot make a fibonacci heap out of an array with negative size.");
+
+    front = nullptr;
+    min = nullptr;
+    numElems = 0;
+    maxDegree = 1;
+    degreeTableLimit = 0;
+    linkBudget = 0;
+    bucketFloor = BucketKey();
+    bucketLow = BucketKey();
+    numBucketed = 0;
+    pendingLimit = 0;
+
+    slabs = nullptr;
+    lastSlab = nullptr;
+    freeNodes = nullptr;
+    lastFreeNode = nullptr;
+
+    insert_range(arr, arr + size);
+}
+
+/*
+ * Range constructor; constructs a fibonacci heap holding the elements 
+ * in [first, last) in linear time. If addrs_out is not null, the 
+ * address of the i-th element is written to addrs_out[i].
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+template <typename ForwardIt>
+FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::FibHeap(ForwardIt first, ForwardIt last, 
+                                        FibHeap_ElemAddr *addrs_out, const Compare &comp) : comp(comp)
+{
+    front = nullptr;
+    min = nullptr;
+    numElems = 0;
+    maxDegree = 1;
+    degreeTableLimit = 0;
+    linkBudget = 0;
+    bucketFloor = BucketKey();
+    bucketLow = BucketKey();
+    numBucketed = 0;
+    pendingLimit = 0;
+
+    slabs = nullptr;
+    lastSlab = nullptr;
+    freeNodes = nullptr;
+    lastFreeNode = nullptr;
+
+    insert_range(first, last, addrs_out);
+}
+
+// destructor
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::~FibHeap()
+{
+    clear();
+}
+
+// copy constructor -- performs deep copy
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::FibHeap(const FibHeap &other) : comp(other.comp)
+{
+    front = nullptr;
+    min = nullptr;
+    numElems = 0;
+    maxDegree = 1;
+    degreeTableLimit = 0;
+    linkBudget = 0;
+    bucketFloor = BucketKey();
+    bucketLow = BucketKey();
+    numBucketed = 0;
+    pendingLimit = 0;
+
+    slabs = nullptr;
+    lastSlab = nullptr;
+    freeNodes = nullptr;
+    lastFreeNode = nullptr;
+    
+    copy_instance(other);
+}
+
+// assignment overload operator
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+FibHeap<Key, Compare, Payload, Index, ErrorPolicy> &FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::operator =(const FibHeap &rhs)
+{
+    if (this != &rhs) {
+        clear();
+
+        comp = rhs.comp;
+        copy_instance(rhs);
+    }
+    return *this;
+}
+
+// move constructor -- takes over other instance's nodes and leaves it empty
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::FibHeap(FibHeap &&other) noexcept : comp(other.comp)
+{
+    front = nullptr;
+    min = nullptr;
+    numElems = 0;
+    maxDegree = 1;
+    degreeTableLimit = 0;
+    linkBudget = 0;
+    bucketFloor = BucketKey();
+    bucketLow = BucketKey();
+    numBucketed = 0;
+    pendingLimit = 0;
+
+    slabs = nullptr;
+    lastSlab = nullptr;
+    freeNodes = nullptr;
+    lastFreeNode = nullptr;
+
+    swap(other);
+}
+
+// move assignment operator -- frees current contents and takes over other's
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+FibHeap<Key, Compare, Payload, Index, ErrorPolicy> &FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::operator =(FibHeap &&rhs) noexcept
+{
+    if (this != &rhs) {
+        clear();
+        swap(rhs);
+    }
+    return *this;
+}
+
+/*
+ * Exchanges contents of this instance with another instance in 
+ * constant time. Addresses of elements stay valid and move with 
+ * their elements to the other instance.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::swap(FibHeap &other) noexcept
+{
+    using std::swap;
+
+    swap(comp, other.comp);
+    swap(front, other.front);
+    swap(min, other.min);
+    swap(numElems, other.numElems);
+    swap(maxDegree, other.maxDegree);
+    degreeTable.swap(other.degreeTable);
+    swap(degreeTableLimit, other.degreeTableLimit);
+    backlog.swap(other.backlog);
+    swap(linkBudget, other.linkBudget);
+    buckets.swap(other.buckets);
+    swap(bucketFloor, other.bucketFloor);
+    swap(bucketLow, other.bucketLow);
+    swap(numBucketed, other.numBucketed);
+    pending.swap(other.pending);
+    swap(pendingLimit, other.pendingLimit);
+    if constexpr (indexed) {
+        index.swap(other.index);
+    }
+
+    swap(slabs, other.slabs);
+    swap(lastSlab, other.lastSlab);
+    swap(freeNodes, other.freeNodes);
+    swap(lastFreeNode, other.lastFreeNode);
+    FIB_HEAP_STAT(swap(statistics, other.statistics));
+}
+
+/* 
+ * Returns whether or not fibonacci heap is empty
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+bool FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::isEmpty() const
+{
+    return numElems == 0;
+}
+
+/*
+ * Returns the number of elements in the fibonacci heap
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+int FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::size() const
+{
+    return numElems;
+}
+
+/*
+ * Retrieves the value of the minimum element in the fibonacci heap
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+Key FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::get_min()
+{
+    flush_pending();
+    ErrorPolicy::check(not isEmpty(), "Heap is empty -- cannot get the minimum element");
+    return top()->value;
+}
+
+/*
+ * Retrieves the value of the minimum element, or an empty optional if 
+ * the heap is empty
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+std::optional<Key> FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::try_get_min()
+{
+    flush_pending();
+    if (isEmpty()) {
+        return std::nullopt;
+    }
+    return top()->value;
+}
+
+/*
+ * Retrieves the value stored at a specific address
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+Key FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::get_value(FibHeap_ElemAddr addr)
+{
+    Node *node = (Node *)addr;
+
+    ErrorPolicy::check(node != nullptr, "Cannot get the value of a null node");
+
+    return node->value;
+}
+
+/*
+ * Retrieves the payload stored alongside the value at a specific address. 
+ * Only available if the heap was declared with a payload type.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+typename FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::PayloadType &FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::get_payload(FibHeap_ElemAddr addr)
+{
+    static_assert(not std::is_void<Payload>::value, "Heap was declared without a payload type");
+    Node *node = (Node *)addr;
+
+    ErrorPolicy::check(node != nullptr, "Cannot get the payload of a null node");
+
+    return node->payload;
+}
+
+/*
+ * Retrieves the payload stored alongside the minimum element
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+typename FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::PayloadType &FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::get_min_payload()
+{
+    flush_pending();
+    ErrorPolicy::check(not isEmpty(), "Heap is empty -- cannot get the payload of the minimum element");
+    return get_payload(top());
+}
+
+/*
+ * Returns whether an element with inputted ID is in the heap. Only 
+ * available if the heap was declared with an index.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+bool FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::contains(const IdType &id) const
+{
+    return get_address_by_id(id) != nullptr;
+}
+
+/*
+ * Retrieves the address of the element with inputted ID in constant 
+ * time, or nullptr if there is no such element. Only available if the 
+ * heap was declared with an index.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+FibHeap_ElemAddr FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::get_address_by_id(const IdType &id) const
+{
+    static_assert(indexed, "Heap was declared without an index");
+    return index.find(id);
+}
+
+/*
+ * Retrieves the ID of the element at a specific address. Only 
+ * available if the heap was declared with an index.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+typename FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::IdType FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::get_id(FibHeap_ElemAddr addr)
+{
+    static_assert(indexed, "Heap was declared without an index");
+    Node *node = (Node *)addr;
+
+    ErrorPolicy::check(node != nullptr and node->hasId, "Cannot get the ID of a node that was inserted without one");
+
+    return node->id;
+}
+
+/*
+ * Retrieves the address of inputted value in the heap. If address 
+ * is not in the heap, returns nullptr. Values are matched by 
+ * equivalence under the heap's comparator. Note that this takes 
+ * linear time in the worst case, and the runtime would be better
+ * if addresses were instead stored by the client in the appropriate
+ * structure.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+FibHeap_ElemAddr FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::get_address(const Key &value)
+{
+    flush_pending();
+    flush_buckets();
+    if (front != nullptr) {
+        // Search in first tree
+        Node *in_front = find_in_subtree(front, value);
+        if (in_front != nullptr) {
+            return in_front;
+        }
+
+        // Search in remaining trees
+        for (Node *curr = front->right; curr != front; curr = curr->right) {
+            Node *in_curr = find_in_subtree(curr, value);
+            if (in_curr != nullptr) {
+                return in_curr;
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+/*
+ * Inserts an element into the fibonacci heap and returns a pointer 
+ * to the node storing that element.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+FibHeap_ElemAddr FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::insert(const Key &value)
+{
+    // Insert value into root of a new tree
+    Node *root = newNode(value);
+    if (bucket_fits(value)) {
+        bucket_insert(root);
+    } else if (pendingLimit > 0) {
+        buffer_insert(root);
+    } else {
+        add_root(root);
+        if (linkBudget != 0) {
+            link_backlog(linkBudget);
+        }
+    }
+
+    numElems++;
+    return root;
+}
+
+/*
+ * Inserts an element along with its payload into the fibonacci heap 
+ * and returns a pointer to the node storing that element. Only 
+ * available if the heap was declared with a payload type.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+FibHeap_ElemAddr FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::insert(const Key &value, const PayloadType &payload)
+{
+    static_assert(not std::is_void<Payload>::value, "Heap was declared without a payload type");
+    Node *root = newNode(value);
+    root->payload = payload;
+    if (bucket_fits(value)) {
+        bucket_insert(root);
+    } else if (pendingLimit > 0) {
+        buffer_insert(root);
+    } else {
+        add_root(root);
+        if (linkBudget != 0) {
+            link_backlog(linkBudget);
+        }
+    }
+
+    numElems++;
+    return root;
+}
+
+/*
+ * Inserts an element with inputted ID into the fibonacci heap and 
+ * returns a pointer to the node storing that element. The element can 
+ * then be found by its ID until it is removed. Only available if the 
+ * heap was declared with an index.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+FibHeap_ElemAddr FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::insert_with_id(const IdType &id, const Key &value)
+{
+    static_assert(indexed, "Heap was declared without an index");
+    ErrorPolicy::check(index.find(id) == nullptr, "An element with the inputted ID is already in the heap");
+
+    Node *root = (Node *)insert(value);
+    root->id = id;
+    root->hasId = true;
+    index.set(id, root);
+    return root;
+}
+
+/*
+ * Inserts every element in [first, last) into the fibonacci heap in 
+ * linear time. Storage for all new nodes is reserved up front, the 
+ * new roots are chained together directly and the minimum among them 
+ * is found along the way. If addrs_out is not null, the address of 
+ * the i-th element is written to addrs_out[i].
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+template <typename ForwardIt>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::insert_range(ForwardIt first, ForwardIt last, FibHeap_ElemAddr *addrs_out)
+{
+    size_t count = std::distance(first, last);
+    if (count == 0) {
+        return;
+    }
+    reserve_nodes(count);
+
+    Node *chainFront = newNode(*first);
+    Node *chainBack = chainFront;
+    Node *chainMin = chainFront;
+    if (addrs_out != nullptr) {
+        addrs_out[0] = chainFront;
+    }
+
+    size_t i = 1;
+    for (ForwardIt itr = std::next(first); itr != last; ++itr, ++i) {
+        Node *node = newNode(*itr);
+        chainBack->right = node;
+        node->left = chainBack;
+        chainBack = node;
+        if (comp(node->value, chainMin->value)) {
+            chainMin = node;
+        }
+        if (addrs_out != nullptr) {
+            addrs_out[i] = node;
+        }
+    }
+    chainBack->right = chainFront;
+    chainFront->left = chainBack;
+
+    splice_roots(chainFront, chainMin);
+    numElems += count;
+}
+
+/*
+ * Removes the minimum element from the fibonacci heap and returns it
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+Key FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::remove_min()
+{
+    flush_pending();
+    ErrorPolicy::check(not isEmpty(), "Heap is empty -- cannot remove the minimum element");
+
+    // A bucketed minimum only has to be taken out of its bucket
+    Node *node = top();
+    if (node != min) {
+        bucket_remove(node);
+        Key old_min = std::move(node->value);
+        numElems--;
+        free_node(node);
+        raise_floor(old_min);
+        return old_min;
+    }
+    raise_floor(min->value);
+    return remove_tree_min();
+}
+
+/*
+ * Removes the minimum of the trees, which min points at, and returns it
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+Key FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::remove_tree_min()
+{
+    Key old_min = std::move(min->value);
+
+    // Promote all children of minimum to roots
+    Node *minNode = min;
+    Node *child = minNode->child;
+    for (int i = 0; i < minNode->numChildren; i++) {
+        Node *next = child->right;
+        FIB_HEAP_PREFETCH(child->child);  // touched if consolidate links child
+        add_root(child);
+        child = next;
+    }
+
+    // Delete nodes storing previous minimum element
+    numElems--;
+    if (linkBudget != 0) {
+        forget_root(minNode);
+    }
+    remove_root(minNode);
+    free_node(minNode);
+
+    // Return to an empty ring if no trees are left
+    if (front == nullptr) {
+        min = nullptr;
+        return old_min;
+    }
+
+    // Merge trees until no two trees have the same degree, or as far as 
+    // the link budget allows
+    restore_min();
+
+    return old_min;
+}
+
+/*
+ * Removes the minimum element from the fibonacci heap and returns it, 
+ * or returns an empty optional if the heap is empty
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+std::optional<Key> FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::try_remove_min()
+{
+    if (isEmpty()) {
+        return std::nullopt;
+    }
+    return remove_min();
+}
+
+/*
+ * Removes the minimum element from the fibonacci heap and returns it, 
+ * moving the payload stored alongside it into `*payload_p`. Only 
+ * available if the heap was declared with a payload type.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+Key FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::remove_min(PayloadType *payload_p)
+{
+    static_assert(not std::is_void<Payload>::value, "Heap was declared without a payload type");
+    flush_pending();
+    ErrorPolicy::check(not isEmpty(), "Heap is empty -- cannot remove the minimum element");
+
+    if (payload_p != nullptr) {
+        *payload_p = std::move(top()->payload);
+    }
+    return remove_min();
+}
+
+/*
+ * Merges trees until no two trees have the same degree, then relinks the 
+ * remaining trees into the ring and points min at the smallest root. 
+ * Trees are held in the degree table while being merged, so the new 
+ * minimum is found by scanning the table rather than the whole ring. 
+ * The table holds at most one tree per degree (about 1.44 log2 n trees), 
+ * all of whose roots were just touched by merging, so this scan stays 
+ * short and in cache however long the ring was.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::consolidate()
+{
+    if (linkBudget != 0) {
+        forget_settled();
+    }
+    reserve_degree_table(numElems);
+    size_t tableSize = degreeTable.size();
+    size_t topDegree = 0;
+
+    // Open up the ring so that trees can be taken off of it one at a time
+    Node *curr = front;
+    front->left->right = nullptr;
+    FIB_HEAP_STAT(size_t numRoots = 0);
+    while (curr != nullptr) {
+        FIB_HEAP_STAT(numRoots++);
+        Node *next = curr->right;
+
+        // Start fetching the next root, and the child list that linking 
+        // curr below another root will touch, before the comparisons 
+        // below, whose mispredicted branches would discard those loads
+        FIB_HEAP_PREFETCH(next);
+        FIB_HEAP_PREFETCH(curr->child);
+        size_t degree = curr->numChildren;
+        while (degreeTable[degree] != nullptr) {
+            curr = merge_trees(curr, degreeTable[degree]);
+            degreeTable[degree] = nullptr;
+            degree++;
+            if (degree == tableSize) {
+                degreeTable.push_back(nullptr);
+                tableSize++;
+            }
+        }
+        degreeTable[degree] = curr;
+        if (degree > topDegree) {
+            topDegree = degree;
+        }
+        curr = next;
+    }
+    FIB_HEAP_STAT(statistics.consolidations++);
+    FIB_HEAP_STAT(statistics.rootsConsolidated += numRoots);
+    FIB_HEAP_STAT(statistics.maxRootListLength = std::max(statistics.maxRootListLength, numRoots));
+
+    // Relink remaining trees into the ring, locating the new minimum 
+    // along the way, and leave the table empty for the next call. With 
+    // a link budget the trees stay in the table, as all of them are linked.
+    front = nullptr;
+    min = nullptr;
+    for (size_t degree = 0; degree <= topDegree; degree++) {
+        Node *root = degreeTable[degree];
+        if (root != nullptr) {
+            if (linkBudget == 0) {
+                degreeTable[degree] = nullptr;
+            }
+            if (front == nullptr) {
+                front = root;
+                root->left = root;
+                root->right = root;
+                min = root;
+            } else {
+                root->right = front;
+                root->left = front->left;
+                front->left->right = root;
+                front->left = root;
+                if (comp(root->value, min->value)) {
+                    min = root;
+                }
+            }
+        }
+    }
+}
+
+/*
+ * Makes sure the degree table has an entry for every degree a tree 
+ * can have in a heap with n elements. A root of degree k has at least 
+ * F(k + 2) descendants (F being the Fibonacci numbers), so the table 
+ * only has to grow when n reaches the next Fibonacci number.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::reserve_degree_table(size_t n)
+{
+    if (n <= degreeTableLimit and not degreeTable.empty()) {
+        return;
+    }
+
+    size_t size = degree_table_size(n, &degreeTableLimit);
+    if (size > degreeTable.size()) {
+        degreeTable.resize(size, nullptr);
+    }
+}
+
+/*
+ * Returns the number of degrees a tree can have in a heap with n 
+ * elements (at least 1), i.e. one more than the largest degree k with 
+ * F(k + 2) <= n. If limit_out is not null, it is set to the largest 
+ * number of elements for which that number of degrees is enough.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+size_t FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::degree_table_size(size_t n, size_t *limit_out)
+{
+    // fib = F(size + 2); grow until a tree of degree `size` is impossible
+    size_t size = 0;
+    size_t prev_fib = 1;
+    size_t fib = 1;
+    while (fib <= n) {
+        size_t next_fib = prev_fib + fib;
+        prev_fib = fib;
+        fib = next_fib;
+        size++;
+    }
+    if (limit_out != nullptr) {
+        *limit_out = fib - 1;
+    }
+    return size < 1 ? 1 : size;
+}
+
+/*
+ * Links roots from the backlog into the degree table, as consolidate 
+ * does for the whole ring, until the backlog is empty or maxLinks trees 
+ * have been linked. A tree still being carried to a higher degree when 
+ * the budget runs out is left at the back of the backlog. The trees 
+ * stay in the ring throughout, so the loser of each link is unlinked 
+ * from it. Only used if there is a link budget.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::link_backlog(size_t maxLinks)
+{
+    reserve_degree_table(numElems);
+    size_t links = 0;
+    while (not backlog.empty()) {
+        Node *curr = backlog.back();
+        size_t degree = curr->numChildren;
+        while (degreeTable[degree] != nullptr) {
+            if (links == maxLinks) {
+                return;
+            }
+            Node *other = degreeTable[degree];
+            degreeTable[degree] = nullptr;
+
+            // merge_trees keeps curr on top unless other is smaller; a 
+            // loser equal to the minimum hands the minimum to the winner
+            Node *winner = comp(other->value, curr->value) ? other : curr;
+            Node *loser = winner == curr ? other : curr;
+            if (loser == min) {
+                min = winner;
+            }
+            remove_root(loser);
+            curr = merge_trees(winner, loser);
+            backlog.back() = curr;
+            links++;
+            degree++;
+            if (degree == degreeTable.size()) {
+                degreeTable.push_back(nullptr);
+            }
+        }
+        degreeTable[degree] = curr;
+        backlog.pop_back();
+    }
+}
+
+/*
+ * Finds the minimum again after it was removed or increased. Without a 
+ * link budget this consolidates the whole ring; with one, it links as 
+ * far as the budget allows and then compares the roots in the degree 
+ * table and in the backlog. The backlog stays short as long as the 
+ * budget keeps up with the links the workload needs (about 2 log2 n 
+ * per remove_min); roots left over pile up in it otherwise, and make 
+ * this comparison longer.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::restore_min()
+{
+    if (linkBudget == 0) {
+        consolidate();
+        return;
+    }
+
+    link_backlog(linkBudget);
+    min = nullptr;
+    for (Node *root : degreeTable) {
+        if (root != nullptr and (min == nullptr or comp(root->value, min->value))) {
+            min = root;
+        }
+    }
+    for (Node *root : backlog) {
+        if (min == nullptr or comp(root->value, min->value)) {
+            min = root;
+        }
+    }
+}
+
+/*
+ * Moves inputted root from the degree table to the backlog if it is 
+ * in the table, before its degree changes. Does nothing if there is 
+ * no link budget.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::unsettle(Node *root)
+{
+    size_t degree = root->numChildren;
+    if (linkBudget != 0 and degree < degreeTable.size() and degreeTable[degree] == root) {
+        degreeTable[degree] = nullptr;
+        backlog.push_back(root);
+    }
+}
+
+/*
+ * Drops inputted root from the degree table or the backlog, before it 
+ * is removed from the ring. Roots just moved to the backlog are at its 
+ * back, so it is searched from there.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::forget_root(Node *root)
+{
+    unsettle(root);
+    for (size_t i = backlog.size(); i-- > 0;) {
+        if (backlog[i] == root) {
+            backlog[i] = backlog.back();
+            backlog.pop_back();
+            return;
+        }
+    }
+}
+
+/*
+ * Empties the degree table and the backlog without touching any node, 
+ * so that they can be rebuilt from the ring (or were made stale by 
+ * freeing the nodes in them)
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::forget_settled()
+{
+    std::fill(degreeTable.begin(), degreeTable.end(), nullptr);
+    backlog.clear();
+}
+
+/*
+ * Returns the node holding the minimum element: the smallest bucketed 
+ * node if it is smaller than the minimum of the trees, and min otherwise. 
+ * The heap must not be empty. bucketLow is first moved up past empty 
+ * buckets to the smallest bucketed key. It never moves below the floor, 
+ * which only rises, and only moves down to a key being bucketed, so 
+ * each bucket passed over here is paid for by the floor rising past it 
+ * or by an insert or decrease, and this takes constant amortized time.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+typename FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::Node *FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::top()
+{
+    if constexpr (bucketable) {
+        if (numBucketed != 0) {
+            while (buckets[bucket_of(bucketLow)] == nullptr) {
+                bucketLow++;
+            }
+            Node *low = buckets[bucket_of(bucketLow)];
+            if (min == nullptr or comp(low->value, min->value)) {
+                return low;
+            }
+        }
+    }
+    return min;
+}
+
+// Returns whether or not inputted node is in a bucket
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+bool FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::in_bucket(const Node *node)
+{
+    return node->parent == nullptr and node->loser;
+}
+
+/*
+ * Returns whether or not inputted value falls in the window of keys 
+ * kept in buckets; always false if the heap is not monotone
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+bool FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::bucket_fits(const Key &value) const
+{
+    if constexpr (bucketable) {
+        typedef typename std::make_unsigned<Key>::type Unsigned;
+        return not buckets.empty() and not (value < bucketFloor) and 
+               (uintmax_t)(Unsigned)((Unsigned)value - (Unsigned)bucketFloor) < buckets.size();
+    } else {
+        return false;
+    }
+}
+
+// Returns the bucket holding inputted value, which must fit in the window
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+size_t FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::bucket_of(const Key &value) const
+{
+    if constexpr (bucketable) {
+        typedef typename std::make_unsigned<Key>::type Unsigned;
+        return (size_t)((uintmax_t)(Unsigned)value & (buckets.size() - 1));
+    } else {
+        return 0;
+    }
+}
+
+/*
+ * Adds inputted node, which must be in no tree and have no children, 
+ * to the bucket for its value, which must fit in the window
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::bucket_insert(Node *node)
+{
+    if constexpr (bucketable) {
+        node->parent = nullptr;
+        node->loser = true;
+        Node *&head = buckets[bucket_of(node->value)];
+        if (head == nullptr) {
+            head = node;
+            node->left = node;
+            node->right = node;
+        } else {
+            node->right = head;
+            node->left = head->left;
+            head->left->right = node;
+            head->left = node;
+        }
+        if (numBucketed == 0 or node->value < bucketLow) {
+            bucketLow = node->value;
+        }
+        numBucketed++;
+    }
+}
+
+/*
+ * Unlinks inputted node from its bucket, leaving it in no tree or 
+ * bucket. bucketLow is left where it is, for top() to move up.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::bucket_remove(Node *node)
+{
+    if constexpr (bucketable) {
+        Node *&head = buckets[bucket_of(node->value)];
+        if (node->right == node) {
+            head = nullptr;
+        } else {
+            if (head == node) {
+                head = node->right;
+            }
+            node->left->right = node->right;
+            node->right->left = node->left;
+        }
+        node->left = nullptr;
+        node->right = nullptr;
+        node->loser = false;
+        numBucketed--;
+    }
+}
+
+/*
+ * Changes the value of inputted bucketed node, moving it to the bucket 
+ * of its new value, or into the ring if that falls outside the window
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::move_bucketed(Node *node, const Key &value)
+{
+    bucket_remove(node);
+    node->value = value;
+    if (bucket_fits(value)) {
+        bucket_insert(node);
+    } else {
+        add_root(node);
+    }
+}
+
+/*
+ * Moves the window of bucketed keys up to start at inputted value, a 
+ * minimum being removed, if that is above where it starts now. Every 
+ * bucketed key is at least the minimum, so all of them stay inside, 
+ * and bucketLow is moved up with the floor so that it never stands for 
+ * a key below the window, whose bucket is shared with one inside it.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::raise_floor(const Key &value)
+{
+    if constexpr (bucketable) {
+        if (not buckets.empty() and bucketFloor < value) {
+            bucketFloor = value;
+            if (bucketLow < bucketFloor) {
+                bucketLow = bucketFloor;
+            }
+        }
+    }
+}
+
+/*
+ * Moves every bucketed node into the ring as a root of its own, for 
+ * operations that need all elements to be in trees. The heap stays 
+ * monotone, so later inserts are bucketed again.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::flush_buckets()
+{
+    if (numBucketed == 0) {
+        return;
+    }
+    for (Node *&head : buckets) {
+        if (head != nullptr) {
+            Node *curr = head;
+            do {
+                Node *next = curr->right;
+                add_root(curr);
+                curr = next;
+            } while (curr != head);
+            head = nullptr;
+        }
+    }
+    numBucketed = 0;
+}
+
+/*
+ * Gives this instance, which must have nothing bucketed, the window of 
+ * another instance and a copy of each of its bucketed nodes
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::copy_buckets(const FibHeap &other)
+{
+    buckets.assign(other.buckets.size(), nullptr);
+    bucketFloor = other.bucketFloor;
+    for (const Node *head : other.buckets) {
+        if (head != nullptr) {
+            const Node *curr = head;
+            do {
+                bucket_insert(copy_node(curr));
+                curr = curr->right;
+            } while (curr != head);
+        }
+    }
+}
+
+/*
+ * Decreases the value held at inputted node address to the 
+ * inputted new value. The inputted new value is expected 
+ * to be less than the value currently held at that address.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::decrease_val(FibHeap_ElemAddr addr, const Key &value)
+{
+    Node *node = (Node *)addr;
+
+    ErrorPolicy::check(node != nullptr, "Cannot decrease the value of a null node");
+
+    ErrorPolicy::check(comp(value, node->value), "ERROR: Can only decrease to a value lower than current value");
+
+    if constexpr (bucketable) {
+        if (in_bucket(node)) {
+            move_bucketed(node, value);
+            return;
+        }
+    }
+
+    // Decrease value at node. A buffered node is in no tree yet, so 
+    // there is nothing more to do for it
+    node->value = value;
+    if (node->left == nullptr) {
+        return;
+    }
+    
+    // If heap invariants are violated, move node with decreased value 
+    // and subtree to a new tree. Then update min if necessary.
+    if (node->parent != nullptr and comp(value, node->parent->value)) {
+        cut_to_root(node);
+    }
+    if (comp(value, min->value)) {
+        min = node;
+    }
+}
+
+/*
+ * Decreases the values held at a batch of node addresses. Each element 
+ * of [first, last) is a pair of an address and the new value for it, 
+ * which is expected to be less than the value currently held at that 
+ * address. The whole batch is checked before any value is changed, and 
+ * the minimum is only updated once at the end. If the same address 
+ * appears more than once, the lowest of its new values is kept.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+template <typename ForwardIt>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::decrease_many(ForwardIt first, ForwardIt last)
+{
+    for (ForwardIt itr = first; itr != last; ++itr) {
+        Node *node = (Node *)itr->first;
+        ErrorPolicy::check(node != nullptr, "Cannot decrease the value of a null node");
+        ErrorPolicy::check(comp(itr->second, node->value), "ERROR: Can only decrease to a value lower than current value");
+    }
+
+    // Cut every node that now violates heap invariants, keeping track of 
+    // the lowest decreased node to compare against the minimum afterwards
+    Node *batchMin = nullptr;
+    for (ForwardIt itr = first; itr != last; ++itr) {
+        Node *node = (Node *)itr->first;
+        if (not comp(itr->second, node->value)) {
+            continue;
+        }
+
+        // Bucketed and buffered nodes are handled as by decrease_val
+        if constexpr (bucketable) {
+            if (in_bucket(node)) {
+                move_bucketed(node, itr->second);
+                continue;
+            }
+        }
+        node->value = itr->second;
+        if (node->left == nullptr) {
+            continue;
+        }
+        if (node->parent != nullptr and comp(node->value, node->parent->value)) {
+            cut_to_root(node);
+        }
+        if (batchMin == nullptr or comp(node->value, batchMin->value)) {
+            batchMin = node;
+        }
+    }
+    if (batchMin != nullptr and comp(batchMin->value, min->value)) {
+        min = batchMin;
+    }
+}
+
+/*
+ * Increases the value held at inputted node address to the inputted 
+ * new value in place; the address stays valid. The inputted new value 
+ * is expected to be greater than the value currently held at that 
+ * address. The node is cut away from its parent and its children are 
+ * promoted to roots, so it ends up as a root without children. Trees 
+ * are only consolidated if the node was the minimum.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::increase_val(FibHeap_ElemAddr addr, const Key &value)
+{
+    Node *node = (Node *)addr;
+
+    ErrorPolicy::check(node != nullptr, "Cannot increase the value of a null node");
+
+    ErrorPolicy::check(comp(node->value, value), "ERROR: Can only increase to a value greater than current value");
+
+    if constexpr (bucketable) {
+        if (in_bucket(node)) {
+            move_bucketed(node, value);
+            return;
+        }
+    }
+
+    // A buffered node is in no tree yet, so only its value changes
+    if (node->left == nullptr) {
+        node->value = value;
+        return;
+    }
+
+    // Cut node from its parent first so that the parent is marked as 
+    // having lost a child, then promote all children of node to roots
+    if (node->parent != nullptr) {
+        cut_to_root(node);
+    }
+    unsettle(node);
+    Node *child = node->child;
+    for (int i = 0; i < node->numChildren; i++) {
+        Node *next = child->right;
+        link_root(child);
+        child = next;
+    }
+    node->child = nullptr;
+    node->numChildren = 0;
+
+    // Increase value at node. Promoted children are no smaller than the 
+    // old value, so the minimum only has to be found again if it was node
+    node->value = value;
+    if (node == min) {
+        restore_min();
+    }
+}
+
+/*
+ * Decreases the value of the element with inputted ID. Only available 
+ * if the heap was declared with an index.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::decrease_val_by_id(const IdType &id, const Key &value)
+{
+    FibHeap_ElemAddr addr = get_address_by_id(id);
+    ErrorPolicy::check(addr != nullptr, "Cannot decrease the value of an ID that is not in the heap");
+    decrease_val(addr, value);
+}
+
+/*
+ * Moves the subtree rooted at inputted non-root node to a new tree 
+ * and updates information on if parent lost a child. If parent 
+ * loses two children, also moves the parent to its own tree. The 
+ * minimum is NOT updated; only the inputted node can have become 
+ * smaller than it, so that is left to the caller.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::cut_to_root(Node *node)
+{
+    Node *curr = node;
+    Node *parent = node->parent;
+    FIB_HEAP_STAT(size_t depth = 0);
+    while (parent != nullptr) {
+        if (parent->parent == nullptr) {
+            unsettle(parent);
+        }
+        cut_child(parent, curr);
+        link_root(curr);
+        FIB_HEAP_STAT(statistics.cuts++);
+        if (parent->loser) {
+            FIB_HEAP_STAT(depth++);
+            curr = parent;
+            parent = parent->parent;
+        } else {
+            if (parent->parent != nullptr) {
+                parent->loser = true;
+            }
+            break;
+        }
+    }
+    FIB_HEAP_STAT(statistics.cascadingCuts += depth);
+    FIB_HEAP_STAT(statistics.maxCascadeDepth = std::max(statistics.maxCascadeDepth, depth));
+}
+
+/*
+ * Deletes node at inputted address from heap
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::delete_elem(FibHeap_ElemAddr addr)
+{
+    Node *node = (Node *)addr;
+
+    ErrorPolicy::check(node != nullptr, "Cannot delete a null node");
+    flush_pending();
+
+    // A bucketed node only has to be taken out of its bucket
+    if constexpr (bucketable) {
+        if (in_bucket(node)) {
+            bucket_remove(node);
+            numElems--;
+            free_node(node);
+            return;
+        }
+    }
+
+    // Make node the root of its own tree and treat it as the minimum, 
+    // as if its value had been decreased below every other value
+    if (node->parent != nullptr) {
+        cut_to_root(node);
+    }
+    min = node;
+    remove_tree_min();
+}
+
+/* 
+ * Changes the node at `*addr_p` to a different value. 
+ * The value is changed in place, so the address of the 
+ * node and `*addr_p` stay the same.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::change_val(FibHeap_ElemAddr *addr_p, const Key &value)
+{
+    Node *node = (Node *)*addr_p;
+
+    if (comp(value, node->value)) {
+        decrease_val(node, value);
+    } else if (comp(node->value, value)) {
+        increase_val(node, value);
+    }
+}
+
+/*
+ * Returns a checked address for the element at inputted address, which 
+ * must be in the heap. The checked address can later be told apart from 
+ * the address of a removed element in constant time.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+FibHeap_CheckedAddr FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::checked_address(FibHeap_ElemAddr addr)
+{
+    Node *node = (Node *)addr;
+
+    ErrorPolicy::check(node != nullptr, "Cannot check the address of a null node");
+
+    return FibHeap_CheckedAddr{addr, node->generation};
+}
+
+/*
+ * Returns whether the element with inputted checked address is still in 
+ * the heap, i.e. its node has not been freed since the address was 
+ * checked. Only the generation stored at the start of the node is read, 
+ * which a freed node keeps too. It is copied out as raw bytes, since 
+ * the storage may hold a FreeNode rather than a Node.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+bool FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::holds(FibHeap_CheckedAddr handle) const
+{
+    if (handle.addr == nullptr) {
+        return false;
+    }
+    uint32_t generation;
+    std::memcpy(&generation, handle.addr, sizeof(generation));
+    return generation == handle.generation;
+}
+
+/*
+ * Retrieves the value of the element with inputted checked address
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+Key FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::get_value(FibHeap_CheckedAddr handle)
+{
+    ErrorPolicy::check(holds(handle), "Cannot get the value of an element that is no longer in the heap");
+
+    return ((Node *)handle.addr)->value;
+}
+
+/*
+ * Retrieves the value of the element with inputted checked address, or 
+ * returns an empty optional if the element has been removed
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+std::optional<Key> FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::try_get_value(FibHeap_CheckedAddr handle)
+{
+    if (not holds(handle)) {
+        return std::nullopt;
+    }
+    return ((Node *)handle.addr)->value;
+}
+
+/*
+ * Decreases the value of the element with inputted checked address (see 
+ * decrease_val)
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::decrease_val(FibHeap_CheckedAddr handle, const Key &value)
+{
+    ErrorPolicy::check(holds(handle), "Cannot decrease the value of an element that is no longer in the heap");
+
+    decrease_val(handle.addr, value);
+}
+
+/*
+ * Decreases the value of the element with inputted checked address and 
+ * returns true, or returns false if the element has been removed
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+bool FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::try_decrease_val(FibHeap_CheckedAddr handle, const Key &value)
+{
+    if (not holds(handle)) {
+        return false;
+    }
+    decrease_val(handle.addr, value);
+    return true;
+}
+
+/*
+ * Deletes the element with inputted checked address. Its node's 
+ * generation moves on, so the checked address is rejected from then on.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::delete_elem(FibHeap_CheckedAddr handle)
+{
+    ErrorPolicy::check(holds(handle), "Cannot delete an element that is no longer in the heap");
+
+    delete_elem(handle.addr);
+}
+
+/*
+ * Deletes the element with inputted checked address and returns true, 
+ * or returns false if the element has already been removed
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+bool FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::try_delete_elem(FibHeap_CheckedAddr handle)
+{
+    if (not holds(handle)) {
+        return false;
+    }
+    delete_elem(handle.addr);
+    return true;
+}
+
+/* 
+ * Merges contents of this instance of a fibonacci heap with 
+ * another instance, and empties contents of other instance. Takes 
+ * constant time: the two rings of roots are spliced together and 
+ * the other instance's node storage is handed over as a whole. With a 
+ * link budget, the other instance's roots also join the backlog, which 
+ * takes time linear in their number.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::merge(FibHeap &other)
+{
+    // Handle cases where either fibonacci heap is empty.
+    if (this == &other or other.isEmpty()) {
+        return;
+    }
+    flush_pending();
+    other.flush_pending();
+    flush_buckets();
+    other.flush_buckets();
+    other.forget_settled();
+    merge_index(other);
+    splice_roots(other.front, other.min);
+    numElems += other.numElems;
+    if (other.maxDegree > maxDegree) {
+        maxDegree = other.maxDegree;
+    }
+
+    // Nodes of other instance live in its slabs, so take ownership of those
+    splice_slabs(other);
+
+    // Set other instance to values for empty heap to avoid double frees
+    other.front = nullptr;
+    other.min = nullptr;
+    other.numElems = 0;
+    other.maxDegree = 2;
+}
+
+/*
+ * Merges contents of an expiring instance into this instance. In 
+ * addition to its elements, this takes over the other instance's 
+ * degree table if it is larger than this instance's.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::merge(FibHeap &&other)
+{
+    if (this == &other) {
+        return;
+    }
+
+    merge(other);
+    if (linkBudget == 0 and other.degreeTable.size() > degreeTable.size()) {
+        degreeTable.swap(other.degreeTable);
+        std::swap(degreeTableLimit, other.degreeTableLimit);
+    }
+}
+
+/*
+ * Buffers up to capacity inserts before linking them into trees; a 
+ * capacity of 0 (the default) turns buffering off. Buffered inserts 
+ * take constant time without touching the ring, and are linked into 
+ * trees together, pairwise, when the buffer fills or when any 
+ * operation other than insert, get_value, decrease_val, increase_val 
+ * or change_val needs them to be in the heap's trees. Addresses of 
+ * buffered elements are valid straight away. Buffers of up to a few 
+ * thousand inserts work best, since their nodes are still in cache when 
+ * they are linked; much larger buffers lose that and are slower.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::set_insert_buffer(size_t capacity)
+{
+    pendingLimit = capacity;
+    if (pending.size() >= pendingLimit) {
+        flush_pending();
+    }
+}
+
+/*
+ * Limits the work of insert and remove_min to at most maxLinks links of 
+ * one tree below another; a budget of 0 (the default) turns the limit 
+ * off. remove_min then links only that many trees of equal degree and 
+ * leaves the remaining roots for later calls, and each insert carries 
+ * on with them, so the ring is consolidated bit by bit rather than all 
+ * at once. The minimum stays exact. This bounds the longest pause, e.g. 
+ * the first remove_min after millions of inserts, at the price of a 
+ * link or so more work per insert; the total number of links is about 
+ * the same. Other operations that consolidate, such as drain, still 
+ * consolidate the whole ring.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::set_link_budget(size_t maxLinks)
+{
+    forget_settled();
+    linkBudget = maxLinks;
+    if (linkBudget != 0 and front != nullptr) {
+        backlog.push_back(front);
+        for (Node *curr = front->right; curr != front; curr = curr->right) {
+            backlog.push_back(curr);
+        }
+    }
+}
+
+/*
+ * Makes the heap monotone, for callers whose removed minimums never 
+ * decrease (such as Dijkstra's algorithm with non-negative weights); a 
+ * window of 0 turns this off. Keys from the last minimum removed up to 
+ * window - 1 above it (window being rounded up to a power of 2) are 
+ * then kept in one bucket per key, outside of the trees, and insert, 
+ * decrease_val, increase_val, delete_elem and remove_min take constant 
+ * amortized time on them. Keys beyond the window, or below the last 
+ * minimum, go into trees as usual, so the order of removal is exact 
+ * even if the keys are not monotone after all. Addresses stay valid 
+ * whether an element is in a bucket or a tree. Operations that walk 
+ * the trees, such as get_address, merge, drain and save, first move 
+ * all bucketed elements into trees. Only available for integer keys 
+ * ordered by std::less.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::set_monotone(size_t window)
+{
+    static_assert(bucketable, "Only heaps of integer keys ordered by std::less can be monotone");
+    flush_buckets();
+
+    size_t size = 0;
+    if (window > 0) {
+        size = 1;
+        while (size < window) {
+            size *= 2;
+        }
+    }
+    buckets.assign(size, nullptr);
+    bucketFloor = min != nullptr ? min->value : std::numeric_limits<Key>::min();
+}
+
+/*
+ * Returns a range over the heap's elements in sorted order, which 
+ * removes the elements it steps past when it is destroyed (see Drain)
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+typename FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::Drain FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::drain()
+{
+    return Drain(*this);
+}
+
+// constructor -- consolidates inputted heap and starts at its minimum
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::Drain::Drain(FibHeap &heap) : heap(&heap)
+{
+    heap.flush_pending();
+    heap.flush_buckets();
+    if (heap.front != nullptr) {
+        heap.consolidate();
+    }
+    heap.seed_candidates(candidates);
+}
+
+// destructor -- removes elements stepped past from the heap
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::Drain::~Drain()
+{
+    if (heap != nullptr) {
+        heap->remove_visited(visited, candidates);
+    }
+}
+
+// move constructor -- the moved-from range no longer removes anything
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::Drain::Drain(Drain &&other) noexcept
+    : heap(other.heap), candidates(std::move(other.candidates)), visited(std::move(other.visited))
+{
+    other.heap = nullptr;
+}
+
+/*
+ * Removes up to k of the smallest elements, writing them to out in 
+ * sorted order, and returns the iterator past the last one written. 
+ * The heap is consolidated once before and once after, rather than 
+ * once per element as with k calls to remove_min.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+template <typename OutputIt>
+OutputIt FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::pop_k(size_t k, OutputIt out)
+{
+    Drain range(*this);
+    typename Drain::iterator itr = range.begin();
+    for (size_t i = 0; i < k and itr != range.end(); i++) {
+        *out = *itr;
+        ++out;
+        ++itr;
+    }
+    return out;
+}
+
+/*
+ * Writes up to k of the smallest elements to out in sorted order, 
+ * without removing them or changing the heap's trees, and returns the 
+ * iterator past the last one written. Only the roots and the children 
+ * of the elements written are looked at, never the rest of the heap. 
+ * Bucketed elements of a monotone heap are moved into trees first.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+template <typename OutputIt>
+OutputIt FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::peek_k(size_t k, OutputIt out)
+{
+    flush_pending();
+    flush_buckets();
+    std::vector<Candidate> candidates;
+    seed_candidates(candidates);
+    for (size_t i = 0; i < k and not candidates.empty(); i++) {
+        *out = candidates.front().value;
+        ++out;
+        next_candidate(candidates);
+    }
+    return out;
+}
+
+/*
+ * Writes the heap to a snapshot file at inputted path, replacing any 
+ * file already there. If order_out is not null, (*order_out)[i] is set 
+ * to the address of the element with snapshot index i. Returns false if 
+ * the file could not be written. Only available if keys, payloads and 
+ * IDs are trivially copyable.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+bool FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::save(const char *path, 
+                                                              std::vector<FibHeap_ElemAddr> *order_out)
+{
+    static_assert(std::is_trivially_copyable<Key>::value, "Only heaps of trivially copyable keys can be saved");
+    static_assert(std::is_trivially_copyable<PayloadType>::value, "Only heaps of trivially copyable payloads can be saved");
+    static_assert(std::is_trivially_copyable<IdType>::value, "Only heaps of trivially copyable IDs can be saved");
+    flush_pending();
+    flush_buckets();
+
+    // Number elements breadth first, recording the number of each parent
+    std::vector<Node *> order;
+    std::vector<uint32_t> parents;
+    order.reserve(numElems);
+    parents.reserve(numElems);
+    if (front != nullptr) {
+        Node *root = front;
+        do {
+            order.push_back(root);
+            parents.push_back(FibHeap_SnapshotRoot);
+            root = root->right;
+        } while (root != front);
+    }
+    size_t minIndex = 0;
+    for (size_t i = 0; i < order.size(); i++) {
+        Node *node = order[i];
+        if (node == min) {
+            minIndex = i;
+        }
+        Node *child = node->child;
+        for (int k = 0; k < node->numChildren; k++) {
+            order.push_back(child);
+            parents.push_back((uint32_t)i);
+            child = child->right;
+        }
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (not out) {
+        return false;
+    }
+    FibHeap_SnapshotHeader header = snapshot_header(order.size(), minIndex);
+    FibHeap_SnapshotLayout layout = FibHeap_snapshot_layout(header);
+    size_t count = order.size();
+    size_t pos = 0;
+    write_array<FibHeap_SnapshotHeader>(out, &pos, 0, 1, [&](size_t) { return header; });
+    write_array<Key>(out, &pos, layout.keys, count, [&](size_t i) { return order[i]->value; });
+    write_array<uint32_t>(out, &pos, layout.parents, count, [&](size_t i) { return parents[i]; });
+    write_array<uint16_t>(out, &pos, layout.degrees, count, 
+                          [&](size_t i) { return order[i]->numChildren; });
+    write_array<uint8_t>(out, &pos, layout.losers, count, 
+                         [&](size_t i) { return (uint8_t)order[i]->loser; });
+    if constexpr (not std::is_void<Payload>::value) {
+        write_array<Payload>(out, &pos, layout.payloads, count, 
+                             [&](size_t i) { return order[i]->payload; });
+    }
+    if constexpr (indexed) {
+        write_array<IdType>(out, &pos, layout.ids, count, 
+                            [&](size_t i) { return order[i]->hasId ? order[i]->id : IdType(); });
+        write_array<uint8_t>(out, &pos, layout.hasIds, count, 
+                             [&](size_t i) { return (uint8_t)order[i]->hasId; });
+    }
+    out.close();
+    if (not out) {
+        return false;
+    }
+
+    if (order_out != nullptr) {
+        order_out->assign(order.begin(), order.end());
+    }
+    return true;
+}
+
+/*
+ * Replaces the contents of the heap with those of the snapshot file at 
+ * inputted path. If addrs_out is not null, (*addrs_out)[i] is set to the 
+ * address of the element with snapshot index i. Returns false, leaving 
+ * the heap empty, if the file could not be read or was not written by 
+ * a heap of the same key, payload and ID types.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+bool FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::load(const char *path, 
+                                                              std::vector<FibHeap_ElemAddr> *addrs_out)
+{
+    clear();
+    std::ifstream in(path, std::ios::binary);
+    if (not in.is_open()) {
+        return false;
+    }
+
+    // Read the header first, so that no more memory than the snapshot 
+    // says it needs, and the file holds, is allocated. Paths that are 
+    // not files of at least a header's size (such as directories) fail 
+    // to be read here.
+    FibHeap_SnapshotHeader header;
+    if (not in.read((char *)&header, sizeof(header))) {
+        return false;
+    }
+    in.seekg(0, std::ios::end);
+    std::streamoff fileSize = in.tellg();
+    if (fileSize < 0 or header.numElems >= FibHeap_SnapshotRoot or header.numElems > (uint64_t)INT_MAX or 
+        FibHeap_snapshot_layout(header).total > (uint64_t)fileSize) {
+        return false;
+    }
+    std::vector<char> data(FibHeap_snapshot_layout(header).total);
+    in.seekg(0);
+    if (not in.read(data.data(), data.size())) {
+        return false;
+    }
+    return load(data.data(), data.size(), addrs_out);
+}
+
+/*
+ * Replaces the contents of the heap with those of a snapshot held in 
+ * memory, such as a mapped snapshot file; otherwise the same as loading 
+ * from a path. The forest is rebuilt as it was saved, in linear time. 
+ * Heap order is not checked, so the snapshot must have been saved by a 
+ * heap with the same comparator.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+bool FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::load(const void *data, size_t size, 
+                                                              std::vector<FibHeap_ElemAddr> *addrs_out)
+{
+    static_assert(std::is_trivially_copyable<Key>::value, "Only heaps of trivially copyable keys can be loaded");
+    static_assert(std::is_trivially_copyable<PayloadType>::value, "Only heaps of trivially copyable payloads can be loaded");
+    static_assert(std::is_trivially_copyable<IdType>::value, "Only heaps of trivially copyable IDs can be loaded");
+    clear();
+
+    FibHeap_SnapshotHeader header;
+    FibHeap_SnapshotHeader expected = snapshot_header(0, 0);
+    if (not FibHeap_read_snapshot_header(data, size, &header) or 
+        header.keySize != expected.keySize or header.payloadSize != expected.payloadSize or 
+        header.idSize != expected.idSize or 
+        (header.numElems > 0 and header.minIndex >= header.numElems)) {
+        return false;
+    }
+    FibHeap_SnapshotLayout layout = FibHeap_snapshot_layout(header);
+    const char *bytes = (const char *)data;
+    size_t count = header.numElems;
+
+    // Parents come before their children, so each element can be linked 
+    // below its parent, or into the ring, as soon as it is made. Arrays 
+    // are copied out with memcpy since the data need not be aligned.
+    std::vector<Node *> nodes(count);
+    for (size_t i = 0; i < count; i++) {
+        Key value;
+        uint32_t parent;
+        uint8_t loser;
+        std::memcpy(&value, bytes + layout.keys + i * sizeof(Key), sizeof(Key));
+        std::memcpy(&parent, bytes + layout.parents + i * sizeof(parent), sizeof(parent));
+        std::memcpy(&loser, bytes + layout.losers + i, sizeof(loser));
+        if (parent != FibHeap_SnapshotRoot and (parent >= i or nodes[parent]->numChildren == UINT8_MAX)) {
+            clear();
+            return false;
+        }
+
+        Node *node = newNode(value);
+        nodes[i] = node;
+        numElems++;
+        if (parent == FibHeap_SnapshotRoot) {
+            link_root(node);
+        } else {
+            link_child(nodes[parent], node);
+            node->loser = loser != 0;
+        }
+        if constexpr (not std::is_void<Payload>::value) {
+            std::memcpy(&node->payload, bytes + layout.payloads + i * sizeof(Payload), sizeof(Payload));
+        }
+        if constexpr (indexed) {
+            uint8_t hasId;
+            std::memcpy(&hasId, bytes + layout.hasIds + i, sizeof(hasId));
+            if (hasId != 0) {
+                std::memcpy(&node->id, bytes + layout.ids + i * sizeof(IdType), sizeof(IdType));
+                if (index.find(node->id) != nullptr) {
+                    clear();
+                    return false;
+                }
+                node->hasId = true;
+                index.set(node->id, node);
+            }
+        }
+    }
+
+    // Check the rebuilt forest against the recorded degrees and minimum. 
+    // No node of a valid heap has more children than the degree table 
+    // has room for, which consolidating relies on.
+    size_t degreeBound = degree_table_size(count, nullptr);
+    for (size_t i = 0; i < count; i++) {
+        uint16_t degree;
+        std::memcpy(&degree, bytes + layout.degrees + i * sizeof(degree), sizeof(degree));
+        if (nodes[i]->numChildren != degree or degree >= degreeBound) {
+            clear();
+            return false;
+        }
+        if (degree > maxDegree) {
+            maxDegree = degree;
+        }
+    }
+    if (count > 0) {
+        if (nodes[header.minIndex]->parent != nullptr) {
+            clear();
+            return false;
+        }
+        min = nodes[header.minIndex];
+    }
+
+    if (addrs_out != nullptr) {
+        addrs_out->assign(nodes.begin(), nodes.end());
+    }
+    return true;
+}
+
+/*
+ * Clears fibonacci heap of all elements. Node storage is released 
+ * a slab at a time rather than node by node.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::clear()
+{
+    flush_buckets();
+    if (not isEmpty()) {
+        // Nodes only need to be visited if they hold something that 
+        // must be destroyed
+        if (not std::is_trivially_destructible<Node>::value) {
+            if (front != nullptr) {
+                Node *curr = front->left;
+                while (curr != front) {
+                    Node *next = curr->left;
+                    delete_subtree(curr);
+                    curr = next;
+                }
+                delete_subtree(front);
+            }
+            for (Node *node : pending) {
+                node->~Node();
+            }
+        }
+        pending.clear();
+
+        FIB_HEAP_STAT(statistics.nodeFrees += numElems);
+        front = nullptr;
+        min = nullptr;
+        numElems = 0;
+        maxDegree = 2;
+    }
+    forget_settled();
+    release_slabs();
+    if constexpr (indexed) {
+        index.clear();
+    }
+}
+
+/*
+ * Returns a deep copy of the heap made by numThreads threads. The root 
+ * trees are shared out between the threads, largest first, and each 
+ * thread copies its trees into slabs of its own, so the threads neither 
+ * wait on each other nor on the global allocator for nodes; the slabs 
+ * are then handed to the copy. The copy has the same trees, root order 
+ * and minimum as this heap. An indexed heap's index is filled in by the 
+ * calling thread once the trees are copied. Small heaps are copied by 
+ * the calling thread alone.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+FibHeap<Key, Compare, Payload, Index, ErrorPolicy> FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::parallel_copy(size_t numThreads) const
+{
+    FibHeap result(comp);
+    std::vector<Node *> roots;
+    std::vector<size_t> order;
+    collect_roots(roots, order);
+    numThreads = parallel_threads(numThreads, roots.size(), numElems);
+    if (numThreads == 1) {
+        result.copy_instance(*this);
+        return result;
+    }
+
+    // Each thread allocates from its own heap, which holds no elements
+    std::vector<FibHeap> arenas;
+    arenas.reserve(numThreads);
+    for (size_t thread = 0; thread < numThreads; thread++) {
+        arenas.emplace_back(comp);
+    }
+    std::vector<Node *> copies(roots.size());
+    Node *minCopy = nullptr;
+    run_parallel(numThreads, roots.size(), [&](size_t thread, size_t task) {
+        copies[order[task]] = arenas[thread].copy_subtree(roots[order[task]]);
+    });
+    for (FibHeap &arena : arenas) {
+        result.splice_slabs(arena);
+        FIB_HEAP_STAT(result.statistics.nodeAllocs += arena.statistics.nodeAllocs);
+        FIB_HEAP_STAT(result.statistics.slabAllocs += arena.statistics.slabAllocs);
+    }
+
+    result.linkBudget = linkBudget;
+    for (size_t i = 0; i < roots.size(); i++) {
+        result.link_root(copies[i]);
+        if (roots[i] == min) {
+            minCopy = copies[i];
+        }
+    }
+    result.min = minCopy;
+    result.maxDegree = maxDegree;
+
+    // The arenas' indices point at the copies but are discarded with 
+    // the arenas, so the copy's index is filled in here
+    if constexpr (indexed) {
+        for (Node *root : copies) {
+            for (Node *node = root; node != nullptr; node = next_in_subtree(node, root, true)) {
+                if (node->hasId) {
+                    result.index.set(node->id, node);
+                }
+            }
+        }
+    }
+
+    for (const Node *node : pending) {
+        result.pending.push_back(result.copy_node(node));
+    }
+    result.copy_buckets(*this);
+    result.numElems = numElems;
+    result.pendingLimit = pendingLimit;
+    return result;
+}
+
+/*
+ * Clears fibonacci heap of all elements like clear(), destroying the 
+ * root trees with numThreads threads. Only heaps whose nodes need 
+ * destroying (e.g. those with std::string payloads) are worth clearing 
+ * this way; others are cleared by the calling thread alone, as their 
+ * storage is released a slab at a time without visiting any node.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::parallel_clear(size_t numThreads)
+{
+    flush_buckets();
+    if (not std::is_trivially_destructible<Node>::value) {
+        std::vector<Node *> roots;
+        std::vector<size_t> order;
+        collect_roots(roots, order);
+        numThreads = parallel_threads(numThreads, roots.size(), numElems);
+        if (numThreads > 1) {
+            run_parallel(numThreads, roots.size(), [&](size_t, size_t task) {
+                delete_subtree(roots[order[task]]);
+            });
+            // Leave only the buffered inserts for clear() to destroy
+            front = nullptr;
+        }
+    }
+    clear();
+}
+
+/*
+ * Prints contents of fibonacci heap
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::print()
+{    
+    flush_pending();
+    flush_buckets();
+    // Print contents of heap
+    int count = 1;
+    if (not isEmpty()) {
+        std::cout << "FRONT: "; print_value(front); std::cout << std::endl;
+        std::cout << "MIN: "; print_value(min); std::cout << std::endl;
+        std::cout << "NUMELEMS: " << numElems << std::endl;
+        std::cout << "MAXDEGREE: " << maxDegree << std::endl;
+        std::cout << std::endl;
+        
+        std::cout << "TREE " << count << ":" << std::endl;
+        std::cout << "Root: "; print_value(front); std::cout << std::endl;
+        std::cout << "Left: "; print_value(front->left); std::cout << std::endl;
+        std::cout << "Right: "; print_value(front->right); std::cout << std::endl;
+        std::cout << std::endl;
+        print_subtree(front);
+        count++;
+        for (Node *curr = front->right; curr != front; curr = curr->right) {
+            std::cout << std::endl;
+            std::cout << "TREE " << count << ":" << std::endl;
+            std::cout << "Root: "; print_value(curr); std::cout << std::endl;
+            std::cout << "Left: "; print_value(curr->left); std::cout << std::endl;
+            std::cout << "Right: "; print_value(curr->right); std::cout << std::endl;
+            std::cout << std::endl;
+            print_subtree(curr);
+            count++;
+        }
+    }
+}
+
+/* 
+ * Create new node holding inputted value 
+ * and return pointer to that node 
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+typename FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::Node *FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::newNode(const Key &value)
+{
+    // Reuse a freed node if possible, otherwise take one from the front slab
+    void *storage;
+    uint32_t generation = 0;
+    if (freeNodes != nullptr) {
+        storage = freeNodes;
+        generation = freeNodes->generation;
+        freeNodes = freeNodes->next;
+        if (freeNodes == nullptr) {
+            lastFreeNode = nullptr;
+        }
+    } else {
+        if (slabs == nullptr or slabs->used == slabs->capacity) {
+            add_slab();
+        }
+        storage = &slabs->nodes[slabs->used];
+        slabs->used++;
+    }
+
+    Node *result = new (storage) Node(value);
+    FIB_HEAP_STAT(statistics.nodeAllocs++);
+
+    result->generation = generation;
+    result->loser = false;
+    result->parent = nullptr;
+    result->child = nullptr;
+    result->numChildren = 0;
+    result->left = nullptr;
+    result->right = nullptr;
+
+    return result;
+}
+
+/*
+ * Destroys inputted node and puts its storage on the free list. The 
+ * generation kept with the storage moves on, so checked addresses of 
+ * the node are rejected from then on.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::free_node(Node *node)
+{
+    if constexpr (indexed) {
+        if (node->hasId) {
+            index.erase(node->id);
+        }
+    }
+    uint32_t generation = node->generation + 1;
+    node->~Node();
+    FIB_HEAP_STAT(statistics.nodeFrees++);
+
+    FreeNode *freed = new (node) FreeNode;
+    freed->generation = generation;
+    freed->next = freeNodes;
+    freeNodes = freed;
+    if (lastFreeNode == nullptr) {
+        lastFreeNode = freed;
+    }
+}
+
+/*
+ * Makes sure that n more nodes can be created without allocating. If 
+ * the front slab is too small, its leftover nodes are moved to the free 
+ * list and a slab large enough for the rest is placed in front.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::reserve_nodes(size_t n)
+{
+    size_t available = 0;
+    if (slabs != nullptr) {
+        available = slabs->capacity - slabs->used;
+    }
+    if (available >= n) {
+        return;
+    }
+
+    while (slabs != nullptr and slabs->used < slabs->capacity) {
+        FreeNode *freed = new (&slabs->nodes[slabs->used]) FreeNode;
+        freed->generation = 0;
+        freed->next = freeNodes;
+        freeNodes = freed;
+        if (lastFreeNode == nullptr) {
+            lastFreeNode = freed;
+        }
+        slabs->used++;
+    }
+    add_slab(n - available);
+}
+
+/*
+ * Allocates a new slab at the front of the slab list. Each slab 
+ * is twice as large as the previous one, up to MAX_SLAB_NODES nodes, 
+ * unless a larger minimum capacity is requested.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::add_slab(size_t min_capacity)
+{
+    size_t capacity = MIN_SLAB_NODES;
+    if (slabs != nullptr) {
+        capacity = slabs->capacity * 2;
+        if (capacity > MAX_SLAB_NODES) {
+            capacity = MAX_SLAB_NODES;
+        }
+    }
+    if (capacity < min_capacity) {
+        capacity = min_capacity;
+    }
+
+    Slab *slab = new Slab;
+    slab->nodes = static_cast<Node *>(::operator new(capacity * sizeof(Node)));
+    slab->capacity = capacity;
+    slab->used = 0;
+    slab->next = slabs;
+    slabs = slab;
+    if (lastSlab == nullptr) {
+        lastSlab = slab;
+    }
+    FIB_HEAP_STAT(statistics.slabAllocs++);
+}
+
+/*
+ * Releases all slabs owned by the heap. Any nodes still in the 
+ * slabs must already have been destroyed.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::release_slabs()
+{
+    while (slabs != nullptr) {
+        Slab *next = slabs->next;
+        ::operator delete(slabs->nodes);
+        delete slabs;
+        slabs = next;
+    }
+    lastSlab = nullptr;
+    freeNodes = nullptr;
+    lastFreeNode = nullptr;
+}
+
+/*
+ * Takes ownership of all slabs and free nodes of other instance in 
+ * constant time. Other instance's slabs are placed after this 
+ * instance's so that the front slab stays the one nodes are taken from.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::splice_slabs(FibHeap &other)
+{
+    if (this == &other) {
+        return;
+    }
+
+    if (other.slabs != nullptr) {
+        if (slabs == nullptr) {
+            slabs = other.slabs;
+        } else {
+            lastSlab->next = other.slabs;
+        }
+        lastSlab = other.lastSlab;
+    }
+    if (other.freeNodes != nullptr) {
+        if (freeNodes == nullptr) {
+            freeNodes = other.freeNodes;
+        } else {
+            lastFreeNode->next = other.freeNodes;
+        }
+        lastFreeNode = other.lastFreeNode;
+    }
+
+    other.slabs = nullptr;
+    other.lastSlab = nullptr;
+    other.freeNodes = nullptr;
+    other.lastFreeNode = nullptr;
+}
+
+/* 
+ * Destroys subtree starting at inputted node (node + all descendents). 
+ * Storage is left in the slabs to be released by release_slabs(). 
+ * Nodes are destroyed in postorder by following parent pointers, so 
+ * no stack space is used however deep the tree is.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::delete_subtree(Node *root)
+{
+    if (root == nullptr) {
+        return;
+    }
+
+    Node *node = root;
+    while (node->child != nullptr) {
+        node = node->child;
+    }
+    while (true) {
+        // Read links before the node is destroyed
+        Node *parent = node->parent;
+        Node *next = node->right;
+        bool last_sibling = node == root or next == parent->child;
+        node->~Node();
+
+        if (node == root) {
+            return;
+        }
+        if (last_sibling) {
+            // All of parent's children are gone, so parent is next
+            node = parent;
+        } else {
+            node = next;
+            while (node->child != nullptr) {
+                node = node->child;
+            }
+        }
+    }
+}
+
+/*
+ * Copy subtree starting at inputted node and return pointer to copy. 
+ * The subtree is walked in preorder by following parent pointers, with 
+ * the copy of the current node tracked alongside it, so no stack space 
+ * is used however deep the tree is.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+typename FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::Node *FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::copy_subtree(const Node *root)
+{
+    if (root == nullptr) {
+        return nullptr;
+    }
+
+    Node *root_cpy = copy_node(root);
+    const Node *node = root;
+    Node *node_cpy = root_cpy;
+    while (true) {
+        if (node->child != nullptr) {
+            node = node->child;
+            Node *child_cpy = copy_node(node);
+            link_child(node_cpy, child_cpy);
+            node_cpy = child_cpy;
+            continue;
+        }
+
+        // Climb until there is a sibling left to copy
+        while (node != root and node->right == node->parent->child) {
+            node = node->parent;
+            node_cpy = node_cpy->parent;
+        }
+        if (node == root) {
+            return root_cpy;
+        }
+        node = node->right;
+        Node *sibling_cpy = copy_node(node);
+        link_child(node_cpy->parent, sibling_cpy);
+        node_cpy = sibling_cpy;
+    }
+}
+
+/*
+ * Returns a new unlinked node holding a copy of inputted node's value, 
+ * payload, ID and loser flag
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+typename FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::Node *FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::copy_node(const Node *node)
+{
+    Node *cpy = newNode(node->value);
+    copy_payload(cpy, node);
+    copy_id(cpy, node);
+    cpy->loser = node->loser;
+    return cpy;
+}
+
+/*
+ * Returns the node after inputted node in a preorder walk of the 
+ * subtree rooted at root, or nullptr once the walk is done. Skips 
+ * node's descendents if descend is false. Only parent pointers and 
+ * sibling links are followed, so walks take no stack space.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+template <typename NodePtr>
+NodePtr FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::next_in_subtree(NodePtr node, NodePtr root, bool descend)
+{
+    if (descend and node->child != nullptr) {
+        return node->child;
+    }
+    while (node != root) {
+        if (node->right != node->parent->child) {
+            return node->right;
+        }
+        node = node->parent;
+    }
+    return nullptr;
+}
+
+/*
+ * Copies the payload of one node into another, if the heap has payloads
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::copy_payload(Node *dest, const Node *src)
+{
+    static_cast<FibHeap_PayloadHolder<Payload> &>(*dest) = 
+        static_cast<const FibHeap_PayloadHolder<Payload> &>(*src);
+}
+
+/*
+ * Gives a copied node the ID of the node it was copied from and points 
+ * the index at the copy, if the heap has an index
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::copy_id(Node *dest, const Node *src)
+{
+    if constexpr (indexed) {
+        dest->id = src->id;
+        dest->hasId = src->hasId;
+        if (src->hasId) {
+            index.set(src->id, dest);
+        }
+    }
+}
+
+/*
+ * Moves entries of other instance's index into this instance's index, 
+ * if the heap has an index. This instance simply takes over the other 
+ * index if it has no elements; otherwise this takes time linear in the 
+ * size of the other instance. Must be called before the other 
+ * instance's roots are spliced into this instance.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::merge_index(FibHeap &other)
+{
+    if constexpr (indexed) {
+        if (front == nullptr) {
+            index.swap(other.index);
+            other.index.clear();
+            return;
+        }
+        std::vector<Node *> to_visit;
+        Node *curr = other.front;
+        do {
+            to_visit.push_back(curr);
+            curr = curr->right;
+        } while (curr != other.front);
+        while (not to_visit.empty()) {
+            Node *node = to_visit.back();
+            to_visit.pop_back();
+            if (node->hasId) {
+                ErrorPolicy::check(index.find(node->id) == nullptr, "Cannot merge heaps that both contain an element with the same ID");
+                index.set(node->id, node);
+            }
+            Node *child = node->child;
+            for (int i = 0; i < node->numChildren; i++) {
+                to_visit.push_back(child);
+                child = child->right;
+            }
+        }
+        other.index.clear();
+    } else {
+        (void)other;
+    }
+}
+
+/*
+ * Merge inputted tree1 and tree2 in constant time and return result.
+ * It is expected that both inputted nodes are roots that have been 
+ * taken off of the ring structure.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+typename FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::Node *FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::merge_trees(Node *tree1, Node *tree2)
+{
+    // Have tree with smaller root adopt tree with larger root
+    if (not comp(tree2->value, tree1->value)) {
+        link_child(tree1, tree2);
+        if ((size_t)tree1->numChildren > maxDegree) {
+            maxDegree = tree1->numChildren;
+        }
+        FIB_HEAP_STAT(statistics.links++);
+        FIB_HEAP_STAT(statistics.peakMaxDegree = std::max(statistics.peakMaxDegree, 
+                                                          (size_t)tree1->numChildren));
+
+        return tree1;
+    } else {
+        return merge_trees(tree2, tree1);
+    }
+    
+}
+
+/* 
+ * Add inputted node and its descendents as a root to the 
+ * fibonacci heap.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::add_root(Node *root)
+{
+    bool wasEmpty = front == nullptr;
+    link_root(root);
+
+    // Update minimum if needed
+    if (not wasEmpty and comp(root->value, min->value)) {
+        min = root;
+    }
+}
+
+/* 
+ * Links inputted node and its descendents into the ring as a new 
+ * tree without updating the minimum, unless the heap was empty.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::link_root(Node *root)
+{
+    root->loser = false;
+    root->parent = nullptr;
+
+    // Case where original heap is empty; create a new tree
+    if (front == nullptr) {
+        front = root;
+        root->right = root;
+        root->left = root;
+        min = root;
+    } 
+    // Otherwise, insert before minimum
+    else {
+        root->right = min;
+        root->left = min->left;
+        min->left->right = root;
+        min->left = root;
+    }
+    if (linkBudget != 0) {
+        backlog.push_back(root);
+    }
+}
+
+/*
+ * Splices another ring of roots, with otherMin being its smallest 
+ * root, into the ring structure in constant time. With a link budget, 
+ * the other ring's roots are also added to the backlog one by one.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::splice_roots(Node *otherFront, Node *otherMin)
+{
+    if (linkBudget != 0) {
+        backlog.push_back(otherFront);
+        for (Node *curr = otherFront->right; curr != otherFront; curr = curr->right) {
+            backlog.push_back(curr);
+        }
+    }
+    if (front == nullptr) {
+        front = otherFront;
+        min = otherMin;
+    } else {
+        // Stitch two rings of roots together
+        Node *back = front->left;
+        Node *other_back = otherFront->left;
+
+        back->right = otherFront;
+        otherFront->left = back;
+        other_back->right = front;
+        front->left = other_back;
+
+        if (comp(otherMin->value, min->value)) {
+            min = otherMin;
+        }
+    }
+}
+
+/* 
+ * Unlink inputted root from the ring structure without
+ * deallocating memory in the actual tree
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::remove_root(Node *root)
+{
+    if (root != nullptr) {
+        if (root == root->left) {
+            front = nullptr;
+            min = nullptr;
+        } else {
+            if (root == front) {
+                front = root->right;
+            }
+            root->left->right = root->right;
+            root->right->left = root->left;
+        }
+        root->left = nullptr;
+        root->right = nullptr;
+    }
+}
+
+/*
+ * Adds inputted node as the last child of parent. The child is expected 
+ * not to be linked into any ring or child list.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::link_child(Node *parent, Node *child)
+{
+    child->parent = parent;
+    if (parent->child == nullptr) {
+        parent->child = child;
+        child->left = child;
+        child->right = child;
+    } else {
+        Node *first = parent->child;
+        child->right = first;
+        child->left = first->left;
+        first->left->right = child;
+        first->left = child;
+    }
+    parent->numChildren++;
+}
+
+/*
+ * Unlinks inputted child from its parent's list of children without 
+ * deallocating memory in the child's subtree
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::cut_child(Node *parent, Node *child)
+{
+    if (child->right == child) {
+        parent->child = nullptr;
+    } else {
+        if (parent->child == child) {
+            parent->child = child->right;
+        }
+        child->left->right = child->right;
+        child->right->left = child->left;
+    }
+    child->left = nullptr;
+    child->right = nullptr;
+    child->parent = nullptr;
+    parent->numChildren--;
+}
+
+/*
+ * Performs a deep copy of another instance and sets current 
+ * instance equal to that copy. This function does NOT 
+ * deallocate any memory currently allocated to this instance
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::copy_instance(const FibHeap &other)
+{
+    linkBudget = other.linkBudget;
+    if (other.front != nullptr) {
+        add_root(copy_subtree(other.front));
+        for (Node *curr = other.front->right; curr != other.front; curr = curr->right) {
+            add_root(copy_subtree(curr));
+        }
+        maxDegree = other.maxDegree;
+    }
+    for (const Node *node : other.pending) {
+        pending.push_back(copy_node(node));
+    }
+    copy_buckets(other);
+    numElems = other.numElems;
+    pendingLimit = other.pendingLimit;
+}
+
+/*
+ * Fills roots with the roots of the heap in ring order, and order with 
+ * their positions in roots, largest tree first. Threads sharing out the 
+ * trees in this order finish at about the same time.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::collect_roots(std::vector<Node *> &roots, 
+                                                                       std::vector<size_t> &order) const
+{
+    if (front != nullptr) {
+        Node *curr = front;
+        do {
+            roots.push_back(curr);
+            curr = curr->right;
+        } while (curr != front);
+    }
+    order.resize(roots.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return roots[a]->numChildren > roots[b]->numChildren;
+    });
+}
+
+/*
+ * Returns the number of threads to share numTasks root trees holding 
+ * numElems elements between, given the number requested (0 for the 
+ * machine's hardware concurrency). Returns 1 when the work is too small 
+ * to be worth splitting.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+size_t FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::parallel_threads(size_t requested, size_t numTasks, 
+                                                                            size_t numElems)
+{
+    if (requested == 0) {
+        requested = std::thread::hardware_concurrency();
+    }
+    if (numElems < MIN_PARALLEL_ELEMS or requested < 2 or numTasks < 2) {
+        return 1;
+    }
+    return std::min(requested, numTasks);
+}
+
+/*
+ * Calls work(thread, task) once for every task in [0, numTasks), using 
+ * numThreads threads numbered from 0, of which the calling thread is 
+ * thread 0. Tasks are handed out in increasing order as threads become 
+ * free, so a thread given a large task is not also left a share of the 
+ * rest.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+template <typename Work>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::run_parallel(size_t numThreads, size_t numTasks, Work work)
+{
+    std::atomic<size_t> nextTask{0};
+    auto worker = [&](size_t thread) {
+        size_t task;
+        while ((task = nextTask.fetch_add(1, std::memory_order_relaxed)) < numTasks) {
+            work(thread, task);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads - 1);
+    for (size_t thread = 1; thread < numThreads; thread++) {
+        threads.emplace_back(worker, thread);
+    }
+    worker(0);
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+}
+
+/*
+ * Adds inputted new node to the buffer of inserts, linking the whole 
+ * buffer into trees once it is full
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::buffer_insert(Node *node)
+{
+    pending.push_back(node);
+    if (pending.size() >= pendingLimit) {
+        flush_pending();
+    }
+}
+
+/*
+ * Links any buffered inserts into trees (see link_pending). Kept apart 
+ * from link_pending so that the common case of an empty buffer is 
+ * inlined into its callers.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::flush_pending()
+{
+    if (not pending.empty()) {
+        link_pending();
+    }
+}
+
+/*
+ * Links all buffered inserts into trees and adds those trees to the 
+ * ring; there must be at least one buffered insert. Buffered nodes are 
+ * linked in pairs, then the resulting trees in pairs, and so on, 
+ * working in place through the buffer. The tree left over from a pass 
+ * with an odd number of trees, and the final tree, become roots, so k 
+ * buffered nodes end up as at most log2(k) + 1 trees of distinct 
+ * degrees instead of k singleton roots.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::link_pending()
+{
+    size_t count = pending.size();
+    while (count > 1) {
+        if (count % 2 == 1) {
+            count--;
+            add_root(pending[count]);
+        }
+        for (size_t i = 0; i < count / 2; i++) {
+            pending[i] = merge_trees(pending[2 * i], pending[2 * i + 1]);
+        }
+        count /= 2;
+    }
+    add_root(pending[0]);
+    pending.clear();
+}
+
+/*
+ * Fills candidates with the roots of the heap, arranged as a heap with 
+ * the smallest on top
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::seed_candidates(std::vector<Candidate> &candidates)
+{
+    candidates.clear();
+    if (front != nullptr) {
+        Node *root = front;
+        do {
+            candidates.push_back(Candidate{root->value, root});
+            root = root->right;
+        } while (root != front);
+    }
+    std::make_heap(candidates.begin(), candidates.end(), CandidateOrder{&comp});
+}
+
+/*
+ * Takes the smallest node off of candidates, replaces it with its 
+ * children, and returns it. Every node smaller than the remaining 
+ * candidates has then been taken, since a node is never smaller than 
+ * its parent.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+typename FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::Node *FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::next_candidate(std::vector<Candidate> &candidates)
+{
+    CandidateOrder order = {&comp};
+    std::pop_heap(candidates.begin(), candidates.end(), order);
+    Node *node = candidates.back().node;
+    candidates.pop_back();
+
+    Node *child = node->child;
+    for (int i = 0; i < node->numChildren; i++) {
+        candidates.push_back(Candidate{child->value, child});
+        std::push_heap(candidates.begin(), candidates.end(), order);
+        child = child->right;
+    }
+    return node;
+}
+
+/*
+ * Removes the nodes taken from candidates by next_candidate, listed in 
+ * visited, starting from a heap's roots. Such a set of nodes holds the 
+ * parent of each of its nodes, so the nodes left in candidates are 
+ * exactly the roots of what remains; they become the new ring, which is 
+ * then consolidated.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::remove_visited(std::vector<Node *> &visited, 
+                                                                        std::vector<Candidate> &candidates)
+{
+    if (visited.empty()) {
+        return;
+    }
+    for (Node *node : visited) {
+        free_node(node);
+    }
+    numElems -= visited.size();
+
+    forget_settled();
+    front = nullptr;
+    min = nullptr;
+    for (const Candidate &root : candidates) {
+        link_root(root.node);
+    }
+    if (front != nullptr) {
+        consolidate();
+    }
+}
+
+/*
+ * Returns the snapshot header for a heap of this type holding count 
+ * elements, the minimum having inputted snapshot index
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+FibHeap_SnapshotHeader FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::snapshot_header(size_t count, 
+                                                                                          size_t minIndex) const
+{
+    FibHeap_SnapshotHeader header = FibHeap_SnapshotHeader();
+    std::memcpy(header.magic, FibHeap_SnapshotMagic, sizeof(header.magic));
+    header.version = FibHeap_SnapshotVersion;
+    header.keySize = sizeof(Key);
+    header.payloadSize = std::is_void<Payload>::value ? 0 : sizeof(PayloadType);
+    header.idSize = indexed ? sizeof(IdType) : 0;
+    header.numElems = count;
+    header.minIndex = minIndex;
+    return header;
+}
+
+/*
+ * Writes count values, get(0) to get(count - 1), to out at inputted 
+ * file offset. Zeros are written first to pad from *pos, the current 
+ * file offset, which is then advanced past the values. Values are 
+ * written in chunks to keep the number of writes down.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+template <typename T, typename Get>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::write_array(std::ostream &out, size_t *pos, 
+                                                                     size_t offset, size_t count, Get get)
+{
+    static const char zeros[64] = {};
+    out.write(zeros, offset - *pos);
+
+    const size_t CHUNK = 4096;
+    std::vector<T> chunk;
+    chunk.reserve(std::min(count, CHUNK));
+    for (size_t i = 0; i < count; i++) {
+        chunk.push_back(get(i));
+        if (chunk.size() == CHUNK or i + 1 == count) {
+            out.write((const char *)chunk.data(), chunk.size() * sizeof(T));
+            chunk.clear();
+        }
+    }
+    *pos = offset + count * sizeof(T);
+}
+
+/*
+ * Searches in subtree of inputted node for value. Returns address if value exists,
+ * and returns nullptr if value does not exist. Subtrees whose root comes 
+ * after value are skipped, since value cannot be below them.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+typename FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::Node *FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::find_in_subtree(Node *root, const Key &value)
+{
+    Node *node = root;
+    while (node != nullptr) {
+        bool descend = not comp(value, node->value);
+        if (descend and not comp(node->value, value)) {
+            return node;
+        }
+        node = next_in_subtree(node, root, descend);
+    }
+    return nullptr;
+}
+
+/* 
+ * Prints contents of one subtree in level order
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::print_subtree(Node *root)
+{
+    if (root == nullptr) {
+        return;
+    }
+    
+    std::queue<Node *> to_print;
+    to_print.push(root);
+
+    while (not to_print.empty()) {
+        Node *curr = to_print.front();
+        to_print.pop();
+
+        print_node(curr);
+
+        Node *child = curr->child;
+        for (int i = 0; i < curr->numChildren; i++) {
+            to_print.push(child);
+            child = child->right;
+        }
+    }
+}
+
+/*
+ * Prints all information stored in inputted node
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::print_node(Node *node)
+{
+    std::cout << "NODE: " << std::endl;
+    if (node != nullptr) {
+        std::cout << "Value: " << node->value << std::endl;
+        std::cout << "Loser: "; print_bool(node->loser); std::cout << std::endl;
+        std::cout << "Parent: "; print_value(node->parent); std::cout << std::endl;
+        std::cout << "Children: "; print_children(node); std::cout << std::endl;
+        std::cout << "NumChildren: " << (int)node->numChildren << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+/*
+ * Prints value stored in a node, or null if node is null
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::print_value(Node *node) {
+    if (node == nullptr) {
+        std::cout << "null";
+    } else {
+        std::cout << node->value;
+    }
+}
+
+/*
+ * Prints comma separated list of values stored in children of a node
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::print_children(Node *node)
+{
+    Node *child = node->child;
+    for (int i = 0; i < node->numChildren; i++) {
+        if (i != 0) {
+            std::cout << ", ";
+        }
+        print_value(child);
+        child = child->right;
+    }
+}
+
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::print_bool(bool tf) {
+    if (tf) {
+        std::cout << "T";
+    } else {
+        std::cout << "F";
+    }
+}
+
+#ifdef FIB_HEAP_STATS
+/*
+ * Returns counts of the work done by this heap since it was created or 
+ * since reset_stats() was last called. Stats move along with the heap's 
+ * contents when it is moved or swapped. A copy only counts work done 
+ * since it was made, starting with the nodes allocated to copy.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+const FibHeap_Stats &FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::stats() const
+{
+    return statistics;
+}
+
+/*
+ * Sets all of the heap's stats back to zero
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+void FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::reset_stats()
+{
+    statistics = FibHeap_Stats();
+}
+#endif
+
+/*
+ * Returns whether or not heap is valid (does not violate heap invariants) and 
+ * prints an error message if this is not the case
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+bool FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::valid() {
+    int countElems = 0;
+    if (front != nullptr) {
+        if (min == nullptr) {
+            std::cerr << "ERROR: Heap is not empty but the minimum pointer is null" << std::endl;
+            return false;
+        }
+        if (not valid_root(front, &countElems)) {
+            return false;
+        }
+        for (Node *curr = front->right; curr != front; curr = curr->right) {
+            if (not valid_root(curr, &countElems)) {
+                return false;
+            }
+        }
+    }
+    for (Node *node : pending) {
+        if (node->parent != nullptr or node->child != nullptr or node->numChildren != 0 or 
+            node->left != nullptr or node->right != nullptr) {
+            std::cerr << "ERROR: Buffered node storing " << node->value 
+                 << " is linked to other nodes." << std::endl;
+            return false;
+        }
+        countElems++;
+    }
+    if (not valid_backlog() or not valid_buckets(&countElems)) {
+        return false;
+    }
+    if (countElems != numElems) {
+        std::cerr << "ERROR: It is reported that there are " << numElems 
+             << " elements in the heap when there are actually " 
+             << countElems << " elements." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/*
+ * Returns whether or not every bucketed node is in the bucket for its 
+ * value, inside the window, and bucketLow is inside the window and no 
+ * larger than any bucketed key. Also increments countElems by the 
+ * number of bucketed nodes. Prints an error message if this is not the case.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+bool FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::valid_buckets(int *countElems) {
+    if constexpr (bucketable) {
+        size_t count = 0;
+        for (size_t b = 0; b < buckets.size(); b++) {
+            Node *head = buckets[b];
+            if (head == nullptr) {
+                continue;
+            }
+            Node *curr = head;
+            do {
+                if (not in_bucket(curr) or curr->child != nullptr or curr->left->right != curr or 
+                    curr->right->left != curr or not bucket_fits(curr->value) or 
+                    bucket_of(curr->value) != b or curr->value < bucketLow) {
+                    std::cerr << "ERROR: Bucket " << b << " holds " << curr->value 
+                         << ", which does not belong there" << std::endl;
+                    return false;
+                }
+                count++;
+                curr = curr->right;
+            } while (curr != head);
+        }
+        if (count != numBucketed or (count != 0 and bucketLow < bucketFloor)) {
+            std::cerr << "ERROR: It is reported that " << numBucketed << " elements are bucketed, from " 
+                 << bucketLow << ", when there are actually " << count << std::endl;
+            return false;
+        }
+        *countElems += count;
+    }
+    return true;
+}
+
+/*
+ * Returns whether or not the degree table and the backlog hold every 
+ * root exactly once, the table holding each root at its degree. Both 
+ * must be empty if there is no link budget. Prints an error message if 
+ * this is not the case.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+bool FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::valid_backlog() {
+    size_t settled = 0;
+    for (size_t degree = 0; degree < degreeTable.size(); degree++) {
+        Node *root = degreeTable[degree];
+        if (root != nullptr) {
+            if (linkBudget == 0 or root->parent != nullptr or root->left == nullptr or 
+                (size_t)root->numChildren != degree) {
+                std::cerr << "ERROR: Degree table holds " << root->value 
+                     << " at degree " << degree << " but it is not a root of that degree" << std::endl;
+                return false;
+            }
+            settled++;
+        }
+    }
+    std::vector<Node *> waiting(backlog);
+    std::sort(waiting.begin(), waiting.end());
+    for (size_t i = 0; i < waiting.size(); i++) {
+        Node *root = waiting[i];
+        size_t degree = root->numChildren;
+        if ((i > 0 and waiting[i - 1] == root) or root->parent != nullptr or root->left == nullptr or 
+            (degree < degreeTable.size() and degreeTable[degree] == root)) {
+            std::cerr << "ERROR: Backlog holds " << root->value 
+                 << " but it is not a root waiting to be linked, or is held twice" << std::endl;
+            return false;
+        }
+    }
+
+    size_t numRoots = 0;
+    if (front != nullptr) {
+        numRoots++;
+        for (Node *curr = front->right; curr != front; curr = curr->right) {
+            numRoots++;
+        }
+    }
+    if (linkBudget != 0 and settled + waiting.size() != numRoots) {
+        std::cerr << "ERROR: There are " << numRoots << " roots but " << settled 
+             << " in the degree table and " << waiting.size() << " in the backlog" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/*
+ * Returns whether or not root and the tree below it is valid.
+ * Also increments countElems by the number of nodes in tree 
+ * rooted at root. Prints an error message if this is not
+ * the case.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+bool FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::valid_root(Node *root, int *countElems) {
+    if (root != nullptr) {
+        if (root->left == nullptr or root->right == nullptr) {
+            std::cerr << "ERROR: Root storing " << root->value << " is not linked into the ring" << std::endl;
+            return false;
+        }
+        if (root->left->right != root or root->right->left != root) {
+            std::cerr << "ERROR: Root storing " << root->value 
+                 << " is not linked consistently with its neighbors in the ring" << std::endl;
+            return false;
+        }
+        if (comp(root->value, min->value)) {
+            std::cerr << "ERROR: Minimum points to " << min->value << " while " 
+                 << root->value << " exists." << std::endl;
+            return false;
+        }
+        if (not valid_subtree(root, countElems)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Returns whether or not subtree with inputted node as root is valid, or does not violate
+ * heap invariants.  Also increments countElems by the number of nodes in tree 
+ * rooted at root. Prints an error message if this is not
+ * the case. Each node's list of children is checked before the walk 
+ * moves into it, so the walk only follows links already known to be valid.
+ */
+template <typename Key, typename Compare, typename Payload, typename Index, typename ErrorPolicy>
+bool FibHeap<Key, Compare, Payload, Index, ErrorPolicy>::valid_subtree(Node *root, int *countElems) {
+    for (Node *node = root; node != nullptr; node = next_in_subtree(node, root, true)) {
+        if (node == root) {
+            if (node->parent != nullptr) {
+                std::cerr << "ERROR: Node storing " << node->value 
+                     << " is a root but does not follow root invariants." << std::endl;
+                return false;
+            }
+        } else {
+            if (node->parent == nullptr) {
+                std::cerr << "ERROR: Node storing " << node->value << " is not a root but has no parent" << std::endl;
+                return false;
+            }
+            if (node->left == nullptr or node->right == nullptr or 
+                node->left->right != node or node->right->left != node) {
+                std::cerr << "ERROR: Node storing " << node->value 
+                     << " is not linked consistently with its siblings." << std::endl;
+                return false;
+            }
+        }
+
+        if constexpr (indexed) {
+            if (node->hasId and index.find(node->id) != node) {
+                std::cerr << "ERROR: Node storing " << node->value 
+                     << " is not the node its ID maps to in the index." << std::endl;
+                return false;
+            }
+        }
+
+        int numChildren = 0;
+        Node *child = node->child;
+        if (child != nullptr) {
+            do {
+                if (numChildren == node->numChildren) {
+                    std::cerr << "ERROR: Node storing " << node->value << " has more than the "
+                         << (int)node->numChildren << " children it is reporting." << std::endl;
+                    return false;
+                }
+                if (child->parent != node) {
+                    std::cerr << "ERROR: Node storing " << node->value << " has a child storing " << child->value 
+                         << " whose parent is not pointing to the original node." << std::endl;
+                    return false;
+                }
+                if (comp(child->value, node->value)) {
+                    std::cerr << "ERROR: Node storing " << node->value << " has a child storing " << child->value
+                         << ", violating min heap invariants." << std::endl;
+                    return false;
+                }
+                if (child->right == nullptr) {
+                    std::cerr << "ERROR: Node storing " << child->value 
+                         << " is not linked consistently with its siblings." << std::endl;
+                    return false;
+                }
+                numChildren++;
+                child = child->right;
+            } while (child != node->child);
+        }
+        if (numChildren != node->numChildren) {
+            std::cerr << "ERROR: Node storing " << node->value << " has " << numChildren << " children but is reporting "
+                 << (int)node->numChildren << " children." << std::endl;
+            return false;
+        }
+
+        (*countElems)++;
+    }
+
+    return true;
+}
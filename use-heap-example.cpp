@@ -18,8 +18,16 @@
 #include <unordered_map>
 #include <string>
 #include <cassert>
+#include <cstdio>
 
 #include "fib-heap.h"
+#include "fib-heap-compact.h"
+#include "fib-heap-small.h"
+#include "fib-heap-rank-pairing.h"
+#include "fib-heap-concurrent.h"
+#include "fib-heap-multi.h"
+#include "fib-heap-graph.h"
+#include "fib-heap-snapshot.h"
 
 using namespace std;
 
@@ -42,10 +50,7 @@ int main() {
 
     /* 
      * Create a heap containing the same elements as an array 
-     * containing numbers 1-10. Note that this method does not
-     * return the addresses of any Nodes in the heap, so it 
-     * is recommended to create an empty heap and use insert()
-     * instead.
+     * containing numbers 1-10. This takes linear time. 
      */
     int nums[10];
     for (int i = 0; i < 10; i++) {
@@ -53,6 +58,15 @@ int main() {
     }
     FibHeap heap2(nums, 10);
 
+    /*
+     * A heap can also be built in linear time from any range of 
+     * elements. If an array of addresses is passed in, the address 
+     * of each element is written to the matching position.
+     */
+    FibHeap_ElemAddr range_addrs[10];
+    FibHeap range_heap(nums, nums + 10, range_addrs);
+    assert(range_heap.get_value(range_addrs[3]) == 4);
+
     /*
      * Make a new heap (heap3) with the contents of an existing 
      * heap (heap2)
@@ -129,7 +143,11 @@ int main() {
     assert(heap1.get_address(2) == address_map[2]);
     assert(heap1.get_value(address_map[2]) == 2);
 
-    /* Change the value 2 back to the value 44. */
+    /* 
+     * Change the value 2 back to the value 44. Values are changed 
+     * in place, so the address of the node stays the same. 
+     * increase_val can also be called directly for increases.
+     */
     heap1.change_val(&address_map[2], 44);
     /* Update address_map to sync with state of heap */
     address_map.insert({44, address_map[2]});
@@ -165,6 +183,303 @@ int main() {
     assert(heap1.isEmpty());
     /* Update address_map to sync with state of heap */
     address_map.clear();
+
+    /*
+     * Heaps can store a payload next to each value, which saves 
+     * keeping a separate map to find out which element was removed. 
+     * The example below stores the name of a vertex with its distance.
+     */
+    FibHeap<double, less<double>, string> distances;
+    distances.insert(4.5, "a");
+    FibHeap_ElemAddr b_addr = distances.insert(7.25, "b");
+    distances.insert(6.0, "c");
+    distances.decrease_val(b_addr, 1.5);
+    assert(distances.get_payload(b_addr) == "b");
+    string vertex;
+    assert(distances.remove_min(&vertex) == 1.5);
+    assert(vertex == "b");
+
+    /*
+     * A heap declared with an index can find elements by an ID given 
+     * at insertion in constant time, so no separate address map is 
+     * needed. The index forgets IDs as their elements are removed.
+     */
+    FibHeap<int, less<int>, void, FibHeap_DenseIndex> vertex_heap;
+    vertex_heap.insert_with_id(0, 12);
+    vertex_heap.insert_with_id(1, 30);
+    vertex_heap.decrease_val_by_id(1, 7);
+    assert(vertex_heap.get_id(vertex_heap.get_address(7)) == 1);
+    assert(vertex_heap.remove_min() == 7);
+    assert(not vertex_heap.contains(1));
+    assert(vertex_heap.get_value(vertex_heap.get_address_by_id(0)) == 12);
+
+    /*
+     * Inserts can be buffered, so that a burst of inserts is linked 
+     * into trees in one pass when the minimum is next needed. Addresses 
+     * of buffered elements can be used right away.
+     */
+    FibHeap timers;
+    timers.set_insert_buffer();
+    FibHeap_ElemAddr timer_addr = timers.insert(50);
+    timers.insert(20);
+    timers.decrease_val(timer_addr, 10);
+    assert(timers.remove_min() == 10);
+
+    /*
+     * With a link budget, insert and remove_min link only a few trees 
+     * each, so no call pauses to link the whole heap at once
+     */
+    FibHeap frames;
+    frames.set_link_budget();
+    for (int i = 100; i > 0; i--) {
+        frames.insert(i);
+    }
+    assert(frames.remove_min() == 1);
+    assert(frames.remove_min() == 2);
+    assert(frames.valid());
+
+    /*
+     * A monotone heap keeps keys just above the last minimum removed in 
+     * buckets; addresses work the same whether an element is in a bucket 
+     * or in a tree
+     */
+    FibHeap arrivals;
+    arrivals.set_monotone(16);
+    arrivals.insert(0);
+    assert(arrivals.remove_min() == 0);
+    FibHeap_ElemAddr far_addr = arrivals.insert(12);
+    arrivals.insert(100);
+    arrivals.decrease_val(far_addr, 5);
+    assert(arrivals.remove_min() == 5);
+    assert(arrivals.remove_min() == 100);
+
+    /* A max heap removes the largest element first */
+    MaxFibHeap<int> max_heap;
+    max_heap.insert(3);
+    max_heap.insert(9);
+    max_heap.insert(5);
+    assert(max_heap.remove_min() == 9);
+
+    /*
+     * Heaps can be moved and swapped in constant time, e.g. when 
+     * returning them from functions or storing them in containers. 
+     * Addresses move along with their elements.
+     */
+    FibHeap_ElemAddr five_addr = max_heap.insert(5);
+    MaxFibHeap<int> moved_heap(std::move(max_heap));
+    assert(max_heap.isEmpty());
+    assert(moved_heap.get_value(five_addr) == 5);
+    swap(moved_heap, max_heap);
+    assert(max_heap.size() == 3);
+
+    /*
+     * try_get_min and try_remove_min return an empty optional instead 
+     * of exiting when the heap is empty. The last template parameter 
+     * picks how other misuse is handled; FibHeap_Unchecked skips all 
+     * checks, for code that is known to use the heap correctly.
+     */
+    FibHeap<int, less<int>, void, FibHeap_NoIndex, FibHeap_Unchecked> fast_heap;
+    assert(not fast_heap.try_get_min());
+    fast_heap.insert(8);
+    assert(fast_heap.try_remove_min() == 8);
+    assert(not fast_heap.try_remove_min().has_value());
+
+    /*
+     * peek_k copies out the k smallest elements in order, and pop_k 
+     * removes them. drain() visits elements in order and removes those 
+     * it has stepped past when the loop ends, so the element that 
+     * stopped the loop stays in the heap.
+     */
+    FibHeap<int> deadlines;
+    for (int deadline : {40, 10, 30, 20, 50}) {
+        deadlines.insert(deadline);
+    }
+    vector<int> soonest;
+    deadlines.peek_k(2, back_inserter(soonest));
+    assert(soonest == vector<int>({10, 20}) and deadlines.size() == 5);
+    soonest.clear();
+    deadlines.pop_k(2, back_inserter(soonest));
+    assert(soonest == vector<int>({10, 20}) and deadlines.size() == 3);
+    for (int deadline : deadlines.drain()) {
+        if (deadline > 30) {
+            break;
+        }
+    }
+    assert(deadlines.size() == 2 and deadlines.get_min() == 40);
+
+    /*
+     * parallel_copy and parallel_clear share the trees of a large heap 
+     * between threads. Small heaps like this one are handled by the 
+     * calling thread, so the result is the same as copying and clearing.
+     */
+    FibHeap<int> what_if = deadlines.parallel_copy();
+    what_if.remove_min();
+    assert(what_if.get_min() == 50 and deadlines.get_min() == 40);
+    what_if.parallel_clear();
+    assert(what_if.isEmpty());
+
+    /*
+     * A checked address can be kept after its element may have been 
+     * removed: the heap tells it apart from a live element's address, 
+     * and the try_ functions return false instead of following it.
+     */
+    FibHeap<int> reminders;
+    FibHeap_CheckedAddr reminder = reminders.checked_address(reminders.insert(15));
+    assert(reminders.holds(reminder) and reminders.get_value(reminder) == 15);
+    reminders.remove_min();
+    reminders.insert(25);
+    assert(not reminders.holds(reminder));
+    assert(not reminders.try_decrease_val(reminder, 5));
+
+    /*
+     * save writes the heap to a file that load rebuilds it from, with 
+     * the same trees. load maps each element's old address (in the 
+     * order save reports) to its new one. FibHeapSnapshot maps the file 
+     * to read its minimum without loading it, and only opens snapshots 
+     * saved by a heap of its key, payload and index types.
+     */
+    FibHeap<int, less<int>, char> saved;
+    FibHeap_ElemAddr saved_addrs[] = {saved.insert(40, 'a'), saved.insert(10, 'b'), saved.insert(30, 'c')};
+    saved.decrease_val(saved_addrs[0], 20);
+    vector<FibHeap_ElemAddr> saved_order, loaded_addrs;
+    assert(saved.save("use-heap-example.snap", &saved_order));
+    FibHeap<int, less<int>, char> loaded;
+    assert(loaded.load("use-heap-example.snap", &loaded_addrs));
+    assert(loaded.size() == 3 and loaded.valid());
+    for (size_t i = 0; i < saved_order.size(); i++) {
+        assert(loaded.get_value(loaded_addrs[i]) == saved.get_value(saved_order[i]));
+        assert(loaded.get_payload(loaded_addrs[i]) == saved.get_payload(saved_order[i]));
+    }
+    FibHeapSnapshot<int, char> snapshot("use-heap-example.snap");
+    assert(snapshot.isOpen() and snapshot.size() == 3 and snapshot.get_min() == 10);
+    assert(not FibHeapSnapshot<int>("use-heap-example.snap").isOpen());
+    FibHeapSnapshot<long long, char> wrong_snapshot("use-heap-example.snap");
+    assert(not wrong_snapshot.isOpen());
+    FibHeap<long long, less<long long>, char> wrong_key;
+    assert(not wrong_key.load("use-heap-example.snap"));
+    remove("use-heap-example.snap");
+
+    /*
+     * CompactFibHeap stores elements in arrays instead of nodes, using 
+     * about half the memory per element. Its handles are indices. 
+     * Merging renumbers the merged-in elements: their handles are 
+     * shifted by the offset that merge returns.
+     */
+    CompactFibHeap<int> compact1, compact2;
+    compact1.insert(6);
+    FibHeap_ElemIndex seven = compact2.insert(7);
+    FibHeap_ElemIndex offset = compact1.merge(compact2);
+    compact1.decrease_val(seven + offset, 2);
+    assert(compact1.remove_min() == 2);
+
+    // A merged-in heap may hold trees of a higher degree than this heap 
+    // has had so far
+    CompactFibHeap<int> few, many;
+    few.insert(-1000);
+    few.insert(-999);
+    few.remove_min();
+    for (int i = 0; i < 33; i++) {
+        many.insert(i);
+    }
+    many.remove_min();
+    few.merge(many);
+    assert(few.remove_min() == -999);
+    assert(few.remove_min() == 1);
+    assert(few.valid());
+
+    /*
+     * SmallFibHeap stores up to its capacity (here 4) of elements 
+     * inside the heap object, and moves them to a FibHeap once it is 
+     * full. Addresses work like FibHeap's and stay valid when the 
+     * elements move.
+     */
+    SmallFibHeap<int, less<int>, FibHeap_ExitOnError, 4> retries;
+    FibHeap_ElemAddr retry = retries.insert(9);
+    for (int i = 0; i < 4; i++) {
+        retries.insert(20 + i);
+    }
+    assert(not retries.isInline());
+    retries.decrease_val(retry, 1);
+    assert(retries.remove_min() == 1 and retries.size() == 4);
+
+    // Copies are deep, also once the elements have moved to a FibHeap
+    SmallFibHeap<int, less<int>, FibHeap_AssertOnError, 4> backoffs;
+    for (int i = 0; i < 6; i++) {
+        backoffs.insert(10 - i);
+    }
+    SmallFibHeap<int, less<int>, FibHeap_AssertOnError, 4> backoffs_copy(backoffs);
+    assert(backoffs.remove_min() == 5);
+    assert(backoffs_copy.size() == 6 and backoffs_copy.remove_min() == 5);
+    assert(backoffs_copy.valid());
+
+    /*
+     * RankPairingHeap has the same core interface as FibHeap but links 
+     * trees as elements are inserted, so inserts never leave work for 
+     * a later remove_min. Code that names its heap type through a 
+     * typedef can switch between the two by changing that one line.
+     */
+    typedef RankPairingHeap<int> RequestQueue;
+    RequestQueue requests;
+    FibHeap_ElemAddr request = requests.insert(70);
+    for (int i = 0; i < 100; i++) {
+        requests.insert(100 + i);
+    }
+    requests.decrease_val(request, 5);
+    assert(requests.remove_min() == 5 and requests.get_min() == 100);
+
+    /*
+     * ConcurrentFibHeap may be shared by many threads. insert does not 
+     * lock, so it cannot return an address; use insert_with_address for 
+     * elements that will be decreased. Removal reports an empty heap by 
+     * returning false, and remove_min_batch takes up to k elements at 
+     * once.
+     */
+    ConcurrentFibHeap<int> jobs;
+    jobs.insert(30);
+    jobs.insert(10);
+    FibHeap_ElemAddr job_addr = jobs.insert_with_address(40);
+    jobs.decrease_val(job_addr, 20);
+    vector<int> next_jobs;
+    assert(jobs.remove_min_batch(2, next_jobs) == 2);
+    assert(next_jobs[0] == 10 and next_jobs[1] == 20);
+    int job;
+    assert(jobs.remove_min(&job) and job == 30);
+    assert(not jobs.remove_min(&job));
+
+    /*
+     * MultiFibHeap spreads elements over many independently locked 
+     * shards. remove_min returns an element near the minimum, not 
+     * always the minimum itself. Handles name the shard and the 
+     * address within it; merging a private heap in returns the shard, 
+     * turning its addresses into handles.
+     */
+    MultiFibHeap<int> relaxed(2);
+    MultiFibHeap_Handle far_handle = relaxed.insert(90);
+    FibHeap<int> local_heap;
+    FibHeap_ElemAddr near_addr = local_heap.insert(80);
+    MultiFibHeap_Handle near_handle = {relaxed.merge(local_heap), near_addr};
+    relaxed.decrease_val(far_handle, 15);
+    relaxed.delete_elem(near_handle);
+    assert(relaxed.get_value(far_handle) == 15);
+    assert(relaxed.remove_min(&job) and job == 15);
+
+    /*
+     * fib-heap-graph.h runs Dijkstra's and Prim's algorithms directly 
+     * on a graph in compressed sparse row form. The edges leaving 
+     * vertex v are edges offsets[v] to offsets[v + 1] - 1. The graph 
+     * below is a triangle 0-1-2 with edge weights 4 (0-1), 1 (1-2) 
+     * and 2 (0-2), with each edge listed in both directions.
+     */
+    FibHeap_CSRGraph<int> graph;
+    graph.offsets = {0, 2, 4, 6};
+    graph.targets = {1, 2, 0, 2, 0, 1};
+    graph.weights = {4, 2, 4, 1, 2, 1};
+    FibHeap_ShortestPaths<int> paths = FibHeap_shortest_paths(graph, 0);
+    assert(paths.dist[1] == 3);
+    assert(paths.parent[1] == 2);
+    assert(FibHeap_shortest_paths(graph, 0, true).dist == paths.dist);
+    FibHeap_SpanningTree<int> tree = FibHeap_spanning_tree(graph);
+    assert(tree.totalWeight == 3);
 }
 
 